@@ -39,7 +39,7 @@
 
 #include <string>
 
-SemanticVersion version;  // used for data conversions
+thread_local SemanticVersion version;  // used for data conversions
 
 static const YamlLookupTable timerModeLut = {
     {TimerData::TIMERMODE_OFF, "OFF"},
@@ -883,6 +883,8 @@ struct convert<FrSkyScreenData> {
 Node convert<ModelData>::encode(const ModelData& rhs)
 {
   version = SemanticVersion(VERSION);
+  // written in the layout of the "semver" below, whatever was read last
+  modelSettingsVersion = SemanticVersion(VERSION);
 
   Node node;
   auto board = getCurrentBoard();
@@ -174,4 +174,5 @@ struct convert_enum
   }
 
 extern SemanticVersion radioSettingsVersion;
-extern SemanticVersion modelSettingsVersion;
+// per thread, models are converted in parallel
+extern thread_local SemanticVersion modelSettingsVersion;
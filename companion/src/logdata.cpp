@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "logdata.h"
+#include "radio/src/logs.h"
+
+static const double powersOf10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+static uint32_t readLogValue(const uchar * p, int size)
+{
+  uint32_t value = 0;
+  for (int i = size - 1; i >= 0; i--) {
+    value = (value << 8) | p[i];
+  }
+  return value;
+}
+
+static QString formatLogValue(int32_t value, int prec)
+{
+  if (prec == 0)
+    return QString::number(value);
+  int divisor = (prec == 1 ? 10 : 100);
+  return QString("%1%2.%3").arg(value < 0 ? "-" : "").arg(abs(value / divisor))
+      .arg(abs(value % divisor), prec, 10, QChar('0'));
+}
+
+static QString formatGpsCoord(int32_t value)
+{
+  return QString("%1%2.%3").arg(value < 0 ? "-" : "").arg(abs(value / 1000000))
+      .arg(abs(value % 1000000), 6, 10, QChar('0'));
+}
+
+// Plain decimal numbers only, the other cells are left to QString::toDouble()
+static bool parseNumber(const char * p, const char * end, double & value)
+{
+  // empty cells have always been plotted as 0
+  if (p == end) {
+    value = 0;
+    return true;
+  }
+
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    p++;
+
+  qint64 mantissa = 0;
+  int digits = 0, decimals = 0;
+  bool point = false;
+  for (; p < end; p++) {
+    if (*p >= '0' && *p <= '9') {
+      // beyond 15 digits the result would not be exact
+      if (++digits > 15)
+        return false;
+      mantissa = mantissa * 10 + (*p - '0');
+      if (point)
+        decimals++;
+    }
+    else if (*p == '.' && !point) {
+      point = true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  if (digits == 0)
+    return false;
+
+  value = mantissa / powersOf10[decimals];
+  if (negative)
+    value = -value;
+  return true;
+}
+
+static int parseDigits(const char * p, int count)
+{
+  int value = 0;
+  for (int i = 0; i < count; i++) {
+    if (p[i] < '0' || p[i] > '9')
+      return -1;
+    value = value * 10 + (p[i] - '0');
+  }
+  return value;
+}
+
+static bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+LogData::LogData() :
+  data(nullptr)
+{
+  clear();
+}
+
+LogData::~LogData()
+{
+  clear();
+}
+
+void LogData::clear()
+{
+  if (data) {
+    file.unmap(const_cast<uchar *>(data));
+    data = nullptr;
+  }
+  file.close();
+  size = 0;
+  binary = false;
+  header.clear();
+  rows.clear();
+  binaryColumns.clear();
+  values.clear();
+  times.clear();
+  errors = 0;
+  lines = 0;
+  cachedDate = QDate();
+  cachedHour = -1;
+  cachedSecs = 0;
+}
+
+bool LogData::load(const QString & filename)
+{
+  clear();
+
+  file.setFileName(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  size = file.size();
+  if (size > 0) {
+    data = file.map(0, size);
+  }
+  if (!data) {
+    clear();
+    return false;
+  }
+
+  bool result;
+  if (size >= 4 && !memcmp(data, LOGS_BINARY_MAGIC, 4)) {
+    binary = true;
+    result = loadBinary();
+  }
+  else {
+    result = loadCsv();
+  }
+
+  if (!result) {
+    clear();
+  }
+  return result;
+}
+
+bool LogData::loadCsv()
+{
+  const char * p = (const char *)data;
+  const char * end = p + size;
+
+  if (size < 9 || memcmp(p, "Date,Time", 9)) {
+    return false;
+  }
+
+  QVector<bool> numeric;
+  QVector<const char *> cells;
+  lines = -1;
+
+  while (p < end) {
+    const char * next = (const char *)memchr(p, '\n', end - p);
+    next = (next ? next + 1 : end);
+
+    // the same as QByteArray::trimmed()
+    const char * line = p;
+    const char * lineEnd = next;
+    while (line < lineEnd && isSpace(*line))
+      line++;
+    while (lineEnd > line && isSpace(lineEnd[-1]))
+      lineEnd--;
+    p = next;
+    lines++;
+
+    // cells[i] is the start of field i, and field i ends at cells[i + 1] - 1
+    cells.clear();
+    cells.append(line);
+    for (const char * c = line; c < lineEnd; c++) {
+      if (*c == ',')
+        cells.append(c + 1);
+    }
+    cells.append(lineEnd + 1);
+    int fields = cells.count() - 1;
+
+    if (header.isEmpty()) {
+      header = QString::fromUtf8(line, lineEnd - line).split(',');
+      numeric.fill(true, fields);
+      values.resize(fields);
+      continue;
+    }
+
+    if (fields != header.count()) {
+      errors++;
+      continue;
+    }
+
+    Row row = { line - (const char *)data, int(lineEnd - line) };
+    rows.append(row);
+    times.append(parseCsvTime(cells[0], cells[1] - 1, cells[1], cells[2] - 1));
+
+    // Date and Time first
+    for (int i = 2; i < fields; i++) {
+      if (numeric[i]) {
+        double value;
+        if (parseNumber(cells[i], cells[i + 1] - 1, value)) {
+          values[i].append(value);
+        }
+        else {
+          numeric[i] = false;
+          values[i] = QVector<double>();
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool LogData::loadBinary()
+{
+  const uchar * p = data;
+  const uchar * end = data + size;
+
+  if (size < LOGS_BINARY_HEADER_SIZE || p[4] != LOGS_BINARY_VERSION) {
+    return false;
+  }
+
+  int columns = readLogValue(p + 6, 2);
+  int rowSize = readLogValue(p + 8, 2);
+  p += LOGS_BINARY_HEADER_SIZE;
+
+  int offset = 0;
+  for (int i = 0; i < columns; i++) {
+    const uchar * name = p + 2;
+    const uchar * nameEnd = name;
+    while (nameEnd < end && *nameEnd)
+      nameEnd++;
+    if (nameEnd >= end || p[0] >= LOGS_COLUMN_COUNT) {
+      return false;
+    }
+    BinaryColumn column = { p[0], p[1], uint16_t(offset), false };
+    if (p[0] == LOGS_COLUMN_TIME) {
+      header << "Date" << "Time";
+      binaryColumns.append(column);
+      column.time = true;
+    }
+    else {
+      header << QString::fromLatin1((const char *)name);
+    }
+    binaryColumns.append(column);
+    offset += logsColumnSize(p[0]);
+    p = nameEnd + 1;
+  }
+
+  if (offset != rowSize || rowSize == 0) {
+    return false;
+  }
+
+  values.resize(header.count());
+
+  // the rows time, seen as a local time as it used to be when the binary
+  // logs were converted to CSV rows
+  bool hasTime = (binaryColumns.at(0).type == LOGS_COLUMN_TIME);
+  for (; end - p >= rowSize; p += rowSize) {
+    Row row = { p - data, rowSize };
+    rows.append(row);
+    if (hasTime) {
+      const uchar * field = p + binaryColumns.at(0).offset;
+      uint32_t secs = readLogValue(field, 4);
+      times.append(localTime(QDate(1970, 1, 1).addDays(secs / 86400), secs % 86400) +
+                   readLogValue(field + 4, 2) / 1000.0);
+    }
+    else {
+      times.append(qQNaN());
+    }
+  }
+
+  return true;
+}
+
+double LogData::localTime(const QDate & date, int secs)
+{
+  int hour = secs / 3600;
+  if (date != cachedDate || hour != cachedHour) {
+    cachedDate = date;
+    cachedHour = hour;
+    cachedSecs = QDateTime(date, QTime(hour, 0)).toSecsSinceEpoch();
+  }
+  return cachedSecs + secs % 3600;
+}
+
+// "yyyy-MM-dd" and "HH:mm:ss" or "HH:mm:ss.zzz"
+double LogData::parseCsvTime(const char * date, const char * dateEnd,
+                             const char * time, const char * timeEnd)
+{
+  if (dateEnd - date != 10 || date[4] != '-' || date[7] != '-' ||
+      timeEnd - time < 8 || time[2] != ':' || time[5] != ':') {
+    return qQNaN();
+  }
+
+  int year = parseDigits(date, 4);
+  int month = parseDigits(date + 5, 2);
+  int day = parseDigits(date + 8, 2);
+  int hour = parseDigits(time, 2);
+  int minute = parseDigits(time + 3, 2);
+  int second = parseDigits(time + 6, 2);
+  QDate d(year, month, day);
+  if (year < 0 || !d.isValid() || hour < 0 || hour > 23 || minute < 0 ||
+      minute > 59 || second < 0 || second > 59) {
+    return qQNaN();
+  }
+
+  double fraction = 0;
+  int decimals = timeEnd - time - 9;
+  if (decimals >= 0) {
+    int value = parseDigits(time + 9, decimals);
+    if (time[8] != '.' || decimals > 9 || value < 0) {
+      return qQNaN();
+    }
+    fraction = value / powersOf10[decimals];
+  }
+
+  return localTime(d, hour * 3600 + minute * 60 + second) + fraction;
+}
+
+QString LogData::text(int row, int column) const
+{
+  if (binary) {
+    return binaryText(row, column);
+  }
+
+  // the rows have been checked to have all their fields
+  const Row & r = rows.at(row);
+  const char * p = (const char *)data + r.offset;
+  const char * end = p + r.length;
+  for (int i = 0; i < column; i++) {
+    p = (const char *)memchr(p, ',', end - p) + 1;
+  }
+  const char * fieldEnd = (const char *)memchr(p, ',', end - p);
+  return QString::fromUtf8(p, (fieldEnd ? fieldEnd : end) - p);
+}
+
+QStringList LogData::rowText(int row) const
+{
+  if (binary) {
+    QStringList result;
+    for (int i = 0; i < header.count(); i++) {
+      result << binaryText(row, i);
+    }
+    return result;
+  }
+
+  const Row & r = rows.at(row);
+  return QString::fromUtf8((const char *)data + r.offset, r.length).split(',');
+}
+
+QString LogData::binaryText(int row, int column) const
+{
+  const BinaryColumn & c = binaryColumns.at(column);
+  const uchar * field = data + rows.at(row).offset + c.offset;
+
+  switch (c.type) {
+    case LOGS_COLUMN_TIME: {
+      QDateTime time = QDateTime::fromSecsSinceEpoch(readLogValue(field, 4), Qt::UTC)
+                           .addMSecs(readLogValue(field + 4, 2));
+      return time.toString(c.time ? "HH:mm:ss.zzz" : "yyyy-MM-dd");
+    }
+    case LOGS_COLUMN_INT8:
+      return formatLogValue((int8_t)field[0], c.prec);
+    case LOGS_COLUMN_INT16:
+      return formatLogValue((int16_t)readLogValue(field, 2), c.prec);
+    case LOGS_COLUMN_INT32:
+      return formatLogValue((int32_t)readLogValue(field, 4), c.prec);
+    case LOGS_COLUMN_GPS: {
+      int32_t latitude = readLogValue(field, 4);
+      int32_t longitude = readLogValue(field + 4, 4);
+      if (latitude && longitude)
+        return formatGpsCoord(latitude) + " " + formatGpsCoord(longitude);
+      return "";
+    }
+    case LOGS_COLUMN_DATETIME:
+      return QString("%1-%2-%3 %4:%5:%6").arg(readLogValue(field, 2), 4, 10, QChar('0'))
+                 .arg(field[2], 2, 10, QChar('0')).arg(field[3], 2, 10, QChar('0'))
+                 .arg(field[4], 2, 10, QChar('0')).arg(field[5], 2, 10, QChar('0'))
+                 .arg(field[6], 2, 10, QChar('0'));
+    case LOGS_COLUMN_TEXT:
+      return QString("\"%1\"").arg(QString::fromLatin1((const char *)field,
+                                                       qstrnlen((const char *)field, LOGS_BINARY_TEXT_LEN)));
+    case LOGS_COLUMN_BITS64:
+      return "0x" + QString("%1%2").arg(readLogValue(field + 4, 4), 8, 16, QChar('0'))
+                        .arg(readLogValue(field, 4), 8, 16, QChar('0')).toUpper();
+  }
+
+  return "";
+}
+
+double LogData::value(int row, int column) const
+{
+  const QVector<double> & numbers = values.at(column);
+  if (!numbers.isEmpty()) {
+    return numbers.at(row);
+  }
+
+  if (binary) {
+    const BinaryColumn & c = binaryColumns.at(column);
+    const uchar * field = data + rows.at(row).offset + c.offset;
+    // same rounding as formatLogValue()
+    double divisor = (c.prec == 0 ? 1 : (c.prec == 1 ? 10 : 100));
+    switch (c.type) {
+      case LOGS_COLUMN_INT8:
+        return (int8_t)field[0] / divisor;
+      case LOGS_COLUMN_INT16:
+        return (int16_t)readLogValue(field, 2) / divisor;
+      case LOGS_COLUMN_INT32:
+        return (int32_t)readLogValue(field, 4) / divisor;
+      default:
+        break;
+    }
+  }
+
+  return text(row, column).toDouble();
+}
+
+QDateTime LogData::timeStamp(int row) const
+{
+  double time = times.at(row);
+  if (qIsNaN(time)) {
+    return QDateTime();
+  }
+  return QDateTime::fromMSecsSinceEpoch(qRound64(time * 1000));
+}
+
+LogTableModel::LogTableModel(QObject * parent) :
+  QAbstractTableModel(parent),
+  log(nullptr)
+{
+}
+
+void LogTableModel::setLogData(const LogData * log)
+{
+  beginResetModel();
+  this->log = log;
+  endResetModel();
+}
+
+int LogTableModel::rowCount(const QModelIndex & parent) const
+{
+  return (log && !parent.isValid()) ? log->rowCount() : 0;
+}
+
+int LogTableModel::columnCount(const QModelIndex & parent) const
+{
+  return (log && !parent.isValid()) ? log->columnCount() : 0;
+}
+
+QVariant LogTableModel::data(const QModelIndex & index, int role) const
+{
+  // the cells are only formatted when the view shows them
+  if (!log || !index.isValid() || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+  return log->text(index.row(), index.column());
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (log && orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+    return log->columnNames().value(section);
+  }
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <QtCore>
+#include <QAbstractTableModel>
+
+// Telemetry log (CSV, or binary as described in radio/src/logs.h) read
+// through a memory mapping of the file. The numeric columns and the time of
+// each row are parsed once when the file is loaded, the text of the cells is
+// only built when it is asked for.
+class LogData
+{
+  public:
+    LogData();
+    ~LogData();
+
+    bool load(const QString & filename);
+    void clear();
+
+    int rowCount() const { return rows.count(); }
+    int columnCount() const { return header.count(); }
+    const QStringList & columnNames() const { return header; }
+
+    // CSV lines skipped because they don't have the header fields count
+    int invalidLines() const { return errors; }
+    int lineCount() const { return lines; }
+
+    QString text(int row, int column) const;
+    QStringList rowText(int row) const;
+    double value(int row, int column) const;
+
+    // local time in seconds since epoch, NaN when the row has no valid time
+    double time(int row) const { return times.at(row); }
+    QDateTime timeStamp(int row) const;
+
+  private:
+    struct Row {
+      qint64 offset;
+      int length;
+    };
+
+    struct BinaryColumn {
+      uint8_t type;
+      uint8_t prec;
+      uint16_t offset;
+      bool time;     // "Time" part of a LOGS_COLUMN_TIME field
+    };
+
+    QFile file;
+    const uchar * data;
+    qint64 size;
+    bool binary;
+    QStringList header;
+    QVector<Row> rows;
+    QVector<BinaryColumn> binaryColumns;
+    QVector<QVector<double>> values;   // empty for the text columns
+    QVector<double> times;
+    int errors;
+    int lines;
+
+    // local time of the last hour converted
+    QDate cachedDate;
+    int cachedHour;
+    qint64 cachedSecs;
+
+    bool loadCsv();
+    bool loadBinary();
+    QString binaryText(int row, int column) const;
+    double localTime(const QDate & date, int secs);
+    double parseCsvTime(const char * date, const char * dateEnd,
+                        const char * time, const char * timeEnd);
+};
+
+class LogTableModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  public:
+    explicit LogTableModel(QObject * parent = nullptr);
+
+    void setLogData(const LogData * log);
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+  private:
+    const LogData * log;
+};
@@ -19,6 +19,7 @@
  */
 
 #include <math.h>
+#include <algorithm>
 #include "logsdialog.h"
 #include "appdata.h"
 #include "ui_logsdialog.h"
@@ -37,11 +38,12 @@ LogsDialog::LogsDialog(QWidget *parent) :
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
 
+  logModel = new LogTableModel(this);
+  ui->logTable->setModel(logModel);
+
   plotLock=false;
 
   colors.append(Qt::green);
@@ -110,13 +112,15 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), SIGNAL(rangeChanged(QCPRange)), this, SLOT(yAxisChangeRanges(QCPRange)));
+  // decimate the graphs again when the time range is zoomed or dragged:
+  connect(axisRect->axis(QCPAxis::atBottom), SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChangeRange(QCPRange)));
 
   // connect some interaction slots:
   connect(ui->customPlot, SIGNAL(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)), this, SLOT(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)));
   connect(ui->customPlot, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(axisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)));
   connect(ui->customPlot, SIGNAL(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*,QMouseEvent*)), this, SLOT(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*)));
   connect(ui->FieldsTW, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
-  connect(ui->logTable, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
+  connect(ui->logTable->selectionModel(), SIGNAL(selectionChanged(QItemSelection, QItemSelection)), this, SLOT(plotLogs()));
   connect(ui->Reset_PB, SIGNAL(clicked()), this, SLOT(plotLogs()));
   connect(ui->SaveSession_PB, SIGNAL(clicked()), this, SLOT(saveSession()));
 }
@@ -236,18 +240,19 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QList<QStringList> LogsDialog::filterGePoints()
 {
   QList<QStringList> result;
 
-  int n = input.count();
+  int n = logData.rowCount();
   if (n == 0) {
     return result;
   }
 
+  const QStringList & header = logData.columnNames();
   int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
+  for (int i=1; i<header.count(); i++) {
+    if (header.at(i) == "GPS") {
       gpscol=i;
     }
   }
@@ -258,16 +263,17 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  result.append(header);
+  QItemSelectionModel * selectionModel = ui->logTable->selectionModel();
+  bool rangeSelected = selectionModel->hasSelection();
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
+  for (int i = 0; i < n; i++) {
+    if ((selectionModel->isRowSelected(i, QModelIndex()) && rangeSelected) || !rangeSelected) {
 
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+      GpsCoord coord = extractGpsCoordinates(logData.text(i, gpscol));
 
       // glitch filter
       if ( glitchFilter.isGlitch(coord) ) {
@@ -282,18 +288,18 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
       }
 
       // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+      result.append(logData.rowText(i));
     }
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << n << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
+  QList<QStringList> dataPoints = filterGePoints();
   int n = dataPoints.count(); // number of points to export
   if (n==0) return;
 
@@ -562,6 +568,7 @@ void LogsDialog::removeAllGraphs()
   cursorA = 0;
   cursorB = 0;
   cursorLine = 0;
+  graphsData.clear();
   ui->labelCursors->setText("");
 }
 
@@ -572,39 +579,32 @@ void LogsDialog::on_fileOpen_BT_clicked()
     g.logDir(fileName);
     ui->FileName_LE->setText(fileName);
     if (cvsFileParse()) {
+      const QStringList & header = logData.columnNames();
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
+      ui->FieldsTW->setRowCount(header.count()-2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
+      for (int i=2; i<header.count(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(header.at(i));
         ui->FieldsTW->setItem(i-2, 0, item);
       }
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
 
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-      QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        sizes.append(ui->logTable->columnWidth(i));
-      }
+      // the widths only depend on the rows in view, the cells are formatted on demand
       ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        ui->logTable->setColumnWidth(i, sizes.at(i));
-      }
+      ui->logTable->resizeColumnsToContents();
+    }
+    else {
+      // the previous log is not kept
+      plotLock = true;
+      ui->FieldsTW->clear();
+      ui->FieldsTW->setRowCount(0);
+      ui->sessions_CB->clear();
+      ui->SaveSession_PB->setEnabled(false);
+      plotLock = false;
+      removeAllGraphs();
     }
   }
 }
@@ -614,95 +614,49 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    // session rows, as found by setFlightSessions()
+    int first = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int last = logData.rowCount();
+    if (index < ui->sessions_CB->count() - 1) {
+      last = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     }
-    // save the filtered records to a new file
+    // save the session records to a new file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
       QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      // add CSV headers from first row of source file
+      output << logData.columnNames().join(",") << '\n';
+      for(int i = first; i < last; i++){
+        output << logData.rowText(i).join(",") << '\n';
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
 bool LogsDialog::cvsFileParse()
 {
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
+  logModel->setLogData(nullptr);
+  logFilename.clear();
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  if (!logData.load(ui->FileName_LE->text())) {
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
 
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
-
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
-
-    logFilename = QFileInfo(file.fileName()).baseName();
+  if (logData.invalidLines() > 1) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(logData.invalidLines()).arg(logData.lineCount()));
   }
 
-  file.close();
-  if (errors > 1) {
-    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
-  }
-
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
+  if (logData.rowCount() == 0) {
+    logData.clear();
     return false;
   }
 
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
+  logModel->setLogData(&logData);
+
   plotLock = true;
   setFlightSessions();
   plotLock = false;
@@ -715,14 +669,6 @@ struct FlightSession {
   QDateTime end;
 };
 
-QDateTime LogsDialog::getRecordTimeStamp(int index)
-{
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
-}
-
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
 {
   int secs = start.secsTo(end);
@@ -740,35 +686,35 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  int n = logData.rowCount();
   // qDebug() << "records" << n;
 
   // find session breaks
   QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
+  double lastvalue = qQNaN();
+  for (int i = 0; i < n; i++) {
+    double tmp = logData.time(i);
+    if (qIsNaN(lastvalue) || (!qIsNaN(tmp) && int(tmp - lastvalue) > 60)) {
+      sessions.push_back(i);
+      // qDebug() << "session index" << i;
     }
     lastvalue = tmp;
   }
-  sessions.push_back(n-1);
+  sessions.push_back(n);
 
   //now construct a list of sessions with their times
   //total time
   int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("time span") + generateDuration(logData.timeStamp(0), logData.timeStamp(n-1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = logData.timeStamp(sessions.at(i-1));
+      QDateTime sessionEnd = logData.timeStamp(sessions.at(i)-1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i-1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -788,13 +734,13 @@ void LogsDialog::on_sessions_CB_currentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logModel->rowCount();
     }
 
     QModelIndex topLeft = ui->logTable->model()->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
     QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+      bottom - 1, logModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -820,20 +766,20 @@ void LogsDialog::plotLogs()
 
   plotsCollection plots;
 
-  QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
-  QVarLengthArray<int> selectedRows;
-
-  if (rowCount) {
-    hasLogSelection = true;
-    foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
+  // the selection ranges, a session is one range whatever its length
+  QVector<int> selectedRows;
+  foreach (const QItemSelectionRange & range, ui->logTable->selectionModel()->selection()) {
+    for (int row = range.top(); row <= range.bottom(); row++) {
+      selectedRows.append(row);
     }
-    std::sort(selectedRows.begin(), selectedRows.end());
-  } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
+  }
+  std::sort(selectedRows.begin(), selectedRows.end());
+  selectedRows.erase(std::unique(selectedRows.begin(), selectedRows.end()), selectedRows.end());
+
+  int rowCount = selectedRows.count();
+  bool hasLogSelection = (rowCount > 0);
+  if (!hasLogSelection) {
+    rowCount = logData.rowCount();
   }
 
   plots.min_x = QDateTime::currentDateTime().toTime_t();
@@ -848,38 +794,22 @@ void LogsDialog::plotLogs()
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
 
+    plotCoords.x.reserve(rowCount);
+    plotCoords.y.reserve(rowCount);
+
     for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
+      int logRow = hasLogSelection ? selectedRows.at(row) : row;
+
+      double time = logData.time(logRow);
+      if (qIsNaN(time)) continue;
+      plotCoords.x.push_back(time);
 
-      y = logValue->text().toDouble();
+      double y = logData.value(logRow, plotColumn);
       plotCoords.y.push_back(y);
 
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
 
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
-      }
-      plotCoords.x.push_back(time);
-
       if (plots.min_x > time) plots.min_x = time;
       if (plots.max_x < time) plots.max_x = time;
     }
@@ -1045,12 +975,20 @@ void LogsDialog::plotLogs()
         break;
     }
 
-    ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
-      plots.coords.at(i).y);
+    // long logs are only drawn with the points that make a difference at the current zoom
+    if (plots.coords.at(i).x.count() > 4 * axisRect->width() &&
+        std::is_sorted(plots.coords.at(i).x.begin(), plots.coords.at(i).x.end())) {
+      graphsData.append(plots.coords.at(i));
+      setGraphData(i, axisRect->axis(QCPAxis::atBottom)->range());
+    } else {
+      graphsData.append(coords_t());
+      ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
+        plots.coords.at(i).y);
+    }
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
-    if (!tracerMaxAlt && (plots.coords.at(i).name.endsWith("(m)") ||
+    if (!tracerMaxAlt && !plots.coords.at(i).x.isEmpty() && (plots.coords.at(i).name.endsWith("(m)") ||
         plots.coords.at(i).name.endsWith(" Alt") ||
         plots.coords.at(i).name.endsWith("(ft)"))) {
       addMaxAltitudeMarker(plots.coords.at(i), ui->customPlot->graph(i));
@@ -1108,6 +1046,62 @@ void LogsDialog::yAxisChangeRanges(QCPRange range)
   }
 }
 
+void LogsDialog::xAxisChangeRange(QCPRange range)
+{
+  for (int i = 0; i < graphsData.count() && i < ui->customPlot->graphCount(); i++) {
+    setGraphData(i, range);
+  }
+}
+
+// Min/max decimation: in each pixel column of the visible range, only the
+// first, last, min and max points are kept, so that a zoomed out graph of a
+// long log still shows all its peaks
+void LogsDialog::setGraphData(int index, const QCPRange & range)
+{
+  const coords_t & c = graphsData.at(index);
+  if (c.x.isEmpty()) return;
+
+  // one more point on each side, for the lines going out of the graph
+  int first = std::lower_bound(c.x.begin(), c.x.end(), range.lower) - c.x.begin();
+  int last = std::upper_bound(c.x.begin(), c.x.end(), range.upper) - c.x.begin();
+  int columns = qMax(1, axisRect->width());
+
+  QVector<double> x, y;
+  x.reserve(4 * columns + 2);
+  y.reserve(4 * columns + 2);
+
+  if (first > 0) {
+    x.append(c.x.at(first - 1));
+    y.append(c.y.at(first - 1));
+  }
+
+  int start = first;
+  while (start < last) {
+    int column = int((c.x.at(start) - range.lower) * columns / range.size());
+    int end = start + 1;
+    int min = start, max = start;
+    while (end < last && int((c.x.at(end) - range.lower) * columns / range.size()) == column) {
+      if (c.y.at(end) < c.y.at(min)) min = end;
+      if (c.y.at(end) > c.y.at(max)) max = end;
+      end++;
+    }
+    int points[4] = { start, qMin(min, max), qMax(min, max), end - 1 };
+    for (int i = 0; i < 4; i++) {
+      if (i == 0 || points[i] != points[i - 1]) {
+        x.append(c.x.at(points[i]));
+        y.append(c.y.at(points[i]));
+      }
+    }
+    start = end;
+  }
+
+  if (last < c.x.count()) {
+    x.append(c.x.at(last));
+    y.append(c.y.at(last));
+  }
+
+  ui->customPlot->graph(index)->setData(x, y);
+}
 
 void LogsDialog::addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph) {
   // find max altitude
@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "logdata.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -82,9 +83,11 @@ private slots:
   void on_sessions_CB_currentIndexChanged(int index);
   void on_mapsButton_clicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRange(QCPRange range);
 
 private:
-  QList<QStringList> csvlog;
+  LogData logData;
+  LogTableModel * logModel;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -102,12 +105,15 @@ private:
   QCPItemTracer * cursorB;
   QCPItemStraightLine * cursorLine;
 
+  // full data of the graphs that are decimated to the visible range
+  QList<coords_t> graphsData;
+
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QList<QStringList> filterGePoints();
   void exportToGoogleEarth();
-  QDateTime getRecordTimeStamp(int index);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
+  void setGraphData(int index, const QCPRange & range);
 
   void addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph);
   void countNumberOfThrows(const coords_t & c, QCPGraph * graph);
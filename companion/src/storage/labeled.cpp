@@ -19,12 +19,59 @@
  */
 
 #include "labeled.h"
+#include "helpers.h"
 #include "firmwares/opentx/opentxinterface.h"
 #include "firmwares/edgetx/edgetxinterface.h"
 #include "miniz.c"    //  Can only be included once!
 
+#include <functional>
 #include <regex>
 
+// One model conversion on a thread of the pool
+class ModelJob : public QRunnable
+{
+  public:
+    ModelJob(const std::function<void(int)> & job, int index):
+      job(job),
+      index(index)
+    {
+    }
+
+    void run() override
+    {
+      job(index);
+    }
+
+  private:
+    const std::function<void(int)> & job;
+    int index;
+};
+
+// Runs job(0) .. job(count - 1) on the given number of threads and waits for
+// them. Each job only writes to its own slot, so the results don't depend on
+// the order in which the threads run.
+static void runModelJobs(int count, int threads, const std::function<void(int)> & job)
+{
+  if (threads == 1) {
+    for (int i = 0; i < count; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  QThreadPool pool;
+  pool.setMaxThreadCount(threads);
+  for (int i = 0; i < count; i++) {
+    pool.start(new ModelJob(job, i));
+  }
+  pool.waitForDone();
+}
+
+int LabelsStorageFormat::modelThreadCount() const
+{
+  return modelThreads > 0 ? modelThreads : QThread::idealThreadCount();
+}
+
 bool LabelsStorageFormat::load(RadioData & radioData)
 {
   StorageType st = getStorageType(filename);
@@ -257,13 +304,27 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
   if (hasLabels)
     radioData.models.resize(modelFiles.size());
 
+  // The files are read one at a time, the archive can't be shared between
+  // threads, then the models are parsed in parallel
+  struct ModelLoad {
+    int modelIdx;
+    std::string filename;
+    QByteArray buffer;
+    bool loaded;
+    QString exception;
+  };
+
+  Stopwatch stopwatch("LabelsStorageFormat::loadYaml");
+  std::vector<ModelLoad> loads;
+  std::vector<bool> slotUsed(radioData.models.size(), false);
+
   for (const auto& mc : modelFiles) {
     qDebug() << "Filename: " << mc.filename.c_str();
 
     if (!hasLabels) {
       if (mc.modelIdx >= 0 && mc.modelIdx < (int)radioData.models.size()) {
         modelIdx = mc.modelIdx;
-        if (!radioData.models[modelIdx].isEmpty()) {
+        if (!radioData.models[modelIdx].isEmpty() || slotUsed[modelIdx]) {
           qDebug() << QString("Warning: file %1 skipped as slot %2 already used").arg(mc.filename.c_str()).arg(mc.modelIdx + 1);
           continue;
         }
@@ -281,31 +342,50 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
       return false;
     }
 
+    loads.push_back({ modelIdx, mc.filename, modelBuffer, false, QString() });
+    slotUsed[modelIdx] = true;
+    modelIdx++;
+  }
+
+  stopwatch.report(QString("read %1 models").arg(loads.size()));
+
+  runModelJobs(loads.size(), modelThreadCount(), [&](int i) {
+    ModelLoad& load = loads[i];
+
     // Please note:
     //  ModelData() use memset to clear everything to 0
     //
-    auto& model = radioData.models[modelIdx];
-
     try {
-      if (!loadModelFromYaml(model,modelBuffer)) {
-        setError(tr("Cannot load ") + filename);
-        return false;
-      }
+      load.loaded = loadModelFromYaml(radioData.models[load.modelIdx], load.buffer);
     } catch(const std::runtime_error& e) {
-      setError(tr("Cannot load ") + filename + ":\n" + QString(e.what()));
+      load.exception = QString(e.what());
+    }
+  });
+
+  stopwatch.report(QString("parsed %1 models on %2 threads").arg(loads.size()).arg(modelThreadCount()));
+
+  // Results in the files order, the first error is reported
+  for (const auto& load : loads) {
+    QString filename = "MODELS/" + QString::fromStdString(load.filename);
+    if (!load.exception.isEmpty()) {
+      setError(tr("Cannot load ") + filename + ":\n" + load.exception);
+      return false;
+    }
+    if (!load.loaded) {
+      setError(tr("Cannot load ") + filename);
       return false;
     }
 
-    model.modelIndex = modelIdx;
-    strncpy(model.filename, mc.filename.c_str(), sizeof(model.filename)-1);
+    auto& model = radioData.models[load.modelIdx];
+    model.modelIndex = load.modelIdx;
+    strncpy(model.filename, load.filename.c_str(), sizeof(model.filename)-1);
 
     if (hasLabels && !strncmp(radioData.generalSettings.currModelFilename,
                                   model.filename, sizeof(model.filename))) {
-      radioData.generalSettings.currModelIndex = modelIdx;
+      radioData.generalSettings.currModelIndex = load.modelIdx;
     }
 
     model.used = true;
-    modelIdx++;
   }
 
   // Add the labels in the models
@@ -356,11 +436,24 @@ bool LabelsStorageFormat::writeYaml(const RadioData & radioData)
     }
   }
 
-  EtxModelfiles modelFiles;
+  // The models are converted in parallel, then written one at a time
+  Stopwatch stopwatch("LabelsStorageFormat::writeYaml");
+  std::vector<const ModelData *> models;
   for (const auto& model : radioData.models) {
+    if (!model.isEmpty())
+      models.push_back(&model);
+  }
 
-    if (model.isEmpty())
-      continue;
+  std::vector<QByteArray> modelsData(models.size());
+  runModelJobs(models.size(), modelThreadCount(), [&](int i) {
+    writeModelToYaml(*models[i], modelsData[i]);
+  });
+
+  stopwatch.report(QString("converted %1 models on %2 threads").arg(models.size()).arg(modelThreadCount()));
+
+  EtxModelfiles modelFiles;
+  for (size_t m = 0; m < models.size(); m++) {
+    const ModelData& model = *models[m];
 
     QString modelFilename;
     if (hasLabels) {
@@ -374,13 +467,13 @@ bool LabelsStorageFormat::writeYaml(const RadioData & radioData)
                           .arg(model.modelIndex, 2, 10, QLatin1Char('0'));
     }
 
-    QByteArray modelData;
-    writeModelToYaml(model, modelData);
-    if (!writeFile(modelData, modelFilename)) {
+    if (!writeFile(modelsData[m], modelFilename)) {
       return false;
     }
   }
 
+  stopwatch.report(QString("wrote %1 models").arg(models.size()));
+
   if (hasLabels) {
     QByteArray labelsListBuffer;
     if (!writeLabelsListToYaml(radioData, labelsListBuffer)
@@ -33,13 +33,18 @@ class LabelsStorageFormat : public StorageFormat
 
   public:
     LabelsStorageFormat(const QString & filename):
-      StorageFormat(filename)
+      StorageFormat(filename),
+      modelThreads(0)
     {
     }
 
     virtual bool load(RadioData & radioData);
     virtual bool write(const RadioData & radioData);
 
+    // Threads converting the YAML models, 0 for all the cores, 1 to convert
+    // them one at a time on the calling thread
+    void setModelThreads(int threads) { modelThreads = threads; }
+
   protected:
     virtual bool loadFile(QByteArray & fileData, const QString & fileName) = 0;
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName) = 0;
@@ -52,4 +57,9 @@ class LabelsStorageFormat : public StorageFormat
     virtual bool writeYaml(const RadioData & radioData);
 
     StorageType probeFormat();
+
+  private:
+    int modelThreads;
+
+    int modelThreadCount() const;
 };
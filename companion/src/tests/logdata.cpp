@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QtCore>
+#include "gtests.h"
+#include "logdata.h"
+#include "radio/src/logs.h"
+
+static QString writeLog(const QTemporaryDir & dir, const QByteArray & content)
+{
+  QString path = dir.filePath("log");
+  QFile file(path);
+  file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+  file.write(content);
+  file.close();
+  return path;
+}
+
+static void appendLE(QByteArray & data, uint32_t value, int size)
+{
+  for (int i = 0; i < size; i++) {
+    data.append(char(value >> (8 * i)));
+  }
+}
+
+TEST(LogData, csv)
+{
+  QTemporaryDir dir;
+  LogData log;
+
+  ASSERT_TRUE(log.load(writeLog(dir,
+      "Date,Time,RxBt(V),Val,Mode\r\n"
+      "2024-05-01,10:20:30.500,7.4,1.5,Acro\r\n"
+      "2024-05-01,10:20:31.000,7.3\r\n"
+      ",,7.2,1e3,Acro\r\n"
+      "2024-05-01,10:20:32,-0.05,,Angle\r\n")));
+
+  EXPECT_EQ(5, log.columnCount());
+  EXPECT_EQ(QString("RxBt(V)"), log.columnNames().at(2));
+
+  // the line without all the fields is skipped
+  EXPECT_EQ(4, log.lineCount());
+  EXPECT_EQ(1, log.invalidLines());
+  ASSERT_EQ(3, log.rowCount());
+
+  EXPECT_DOUBLE_EQ(7.4, log.value(0, 2));
+  EXPECT_DOUBLE_EQ(7.2, log.value(1, 2));
+  EXPECT_DOUBLE_EQ(-0.05, log.value(2, 2));
+
+  // "1e3" is not a plain decimal, the column is then read from its text
+  EXPECT_DOUBLE_EQ(1.5, log.value(0, 3));
+  EXPECT_DOUBLE_EQ(1000, log.value(1, 3));
+  EXPECT_DOUBLE_EQ(0, log.value(2, 3));
+
+  EXPECT_EQ(QString("Acro"), log.text(1, 4));
+  EXPECT_EQ(QStringList({"2024-05-01", "10:20:32", "-0.05", "", "Angle"}), log.rowText(2));
+
+  EXPECT_EQ(QDateTime(QDate(2024, 5, 1), QTime(10, 20, 30, 500)), log.timeStamp(0));
+  EXPECT_TRUE(qIsNaN(log.time(1)));
+  EXPECT_FALSE(log.timeStamp(1).isValid());
+  EXPECT_EQ(QDateTime(QDate(2024, 5, 1), QTime(10, 20, 32)), log.timeStamp(2));
+}
+
+TEST(LogData, csvInvalidTime)
+{
+  QTemporaryDir dir;
+  LogData log;
+
+  ASSERT_TRUE(log.load(writeLog(dir,
+      "Date,Time,A\n"
+      "2024-02-30,10:20:30,1\n"
+      "2024-05-01,10:61:00,2\n"
+      "2024-05-01,10:20:30,5,3\n"
+      "2024-05-01,10:20:30:500,4\n"
+      "2024-05-01,10:20:30.250,5\n")));
+
+  EXPECT_EQ(1, log.invalidLines());
+  ASSERT_EQ(4, log.rowCount());
+  EXPECT_TRUE(qIsNaN(log.time(0)));
+  EXPECT_TRUE(qIsNaN(log.time(1)));
+  EXPECT_TRUE(qIsNaN(log.time(2)));
+  EXPECT_EQ(QDateTime(QDate(2024, 5, 1), QTime(10, 20, 30, 250)), log.timeStamp(3));
+  EXPECT_DOUBLE_EQ(4, log.value(2, 2));
+}
+
+TEST(LogData, notALog)
+{
+  QTemporaryDir dir;
+  LogData log;
+
+  EXPECT_FALSE(log.load(writeLog(dir, "Hello\n")));
+  EXPECT_EQ(0, log.rowCount());
+  EXPECT_EQ(0, log.columnCount());
+  EXPECT_FALSE(log.load(writeLog(dir, "")));
+  EXPECT_FALSE(log.load(dir.filePath("missing")));
+}
+
+TEST(LogData, binary)
+{
+  QTemporaryDir dir;
+  LogData log;
+
+  QByteArray data(LOGS_BINARY_MAGIC, 4);
+  appendLE(data, LOGS_BINARY_VERSION, 1);
+  appendLE(data, LOGS_BINARY_FLAG_RTC, 1);
+  appendLE(data, 3, 2);
+  appendLE(data, 6 + 2 + LOGS_BINARY_TEXT_LEN, 2);
+  data.append(char(LOGS_COLUMN_TIME)).append(char(0)).append("Time", 5);
+  data.append(char(LOGS_COLUMN_INT16)).append(char(1)).append("RxBt(V)", 8);
+  data.append(char(LOGS_COLUMN_TEXT)).append(char(0)).append("Mode", 5);
+
+  // 2024-05-01 10:20:30.250 UTC
+  appendLE(data, 1714558830, 4);
+  appendLE(data, 250, 2);
+  appendLE(data, 74, 2);
+  data.append(QByteArray("Acro").leftJustified(LOGS_BINARY_TEXT_LEN, '\0'));
+
+  appendLE(data, 1714558831, 4);
+  appendLE(data, 0, 2);
+  appendLE(data, uint16_t(-5), 2);
+  data.append(QByteArray(LOGS_BINARY_TEXT_LEN, '\0'));
+
+  // a row not fully written
+  appendLE(data, 1714558832, 4);
+
+  ASSERT_TRUE(log.load(writeLog(dir, data)));
+  EXPECT_EQ(QStringList({"Date", "Time", "RxBt(V)", "Mode"}), log.columnNames());
+  ASSERT_EQ(2, log.rowCount());
+
+  EXPECT_EQ(QStringList({"2024-05-01", "10:20:30.250", "7.4", "\"Acro\""}), log.rowText(0));
+  EXPECT_EQ(QString("-0.5"), log.text(1, 2));
+  EXPECT_DOUBLE_EQ(7.4, log.value(0, 2));
+  EXPECT_DOUBLE_EQ(-0.5, log.value(1, 2));
+
+  // the time is read as a local time, as in the CSV logs
+  EXPECT_EQ(QDateTime(QDate(2024, 5, 1), QTime(10, 20, 30, 250)), log.timeStamp(0));
+  EXPECT_EQ(QDateTime(QDate(2024, 5, 1), QTime(10, 20, 31)), log.timeStamp(1));
+
+  // unknown version
+  log.clear();
+  data[4] = LOGS_BINARY_VERSION + 1;
+  EXPECT_FALSE(log.load(writeLog(dir, data)));
+}
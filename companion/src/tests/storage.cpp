@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <QtCore>
+#include "gtests.h"
+#include "location.h"
+#include "storage/etx.h"
+#include "firmwares/edgetx/edgetxinterface.h"
+
+// The models written and read again one at a time, and on several threads
+TEST(Storage, YamlModelsThreads)
+{
+  QTemporaryDir dir;
+  RadioData radio;
+  EtxFormat original(RADIO_TESTS_PATH "/model_22_x10.etx");
+  ASSERT_TRUE(original.load(radio));
+
+  const int count = 8;
+  if ((int)radio.models.size() < count)
+    radio.models.resize(count);
+  for (int i = 0; i < count; i++) {
+    ModelData & model = radio.models[i];
+    model.setDefaultValues(i, radio.generalSettings);
+    snprintf(model.filename, sizeof(model.filename), "model%02d.yml", i + 1);
+    model.modelIndex = i;
+    model.mixData[0].weight = 10 * (i + 1);
+  }
+
+  EtxFormat sequential(dir.filePath("sequential.etx"));
+  sequential.setModelThreads(1);
+  ASSERT_TRUE(sequential.write(radio));
+
+  EtxFormat parallel(dir.filePath("parallel.etx"));
+  parallel.setModelThreads(4);
+  ASSERT_TRUE(parallel.write(radio));
+
+  RadioData sequentialRadio, parallelRadio;
+  ASSERT_TRUE(sequential.load(sequentialRadio));
+  ASSERT_TRUE(parallel.load(parallelRadio));
+  ASSERT_EQ(sequentialRadio.models.size(), parallelRadio.models.size());
+
+  int models = 0;
+  for (unsigned i = 0; i < sequentialRadio.models.size(); i++) {
+    const ModelData & model = sequentialRadio.models[i];
+    ASSERT_EQ(model.isEmpty(), parallelRadio.models[i].isEmpty());
+    if (model.isEmpty())
+      continue;
+
+    QByteArray sequentialYaml, parallelYaml;
+    ASSERT_TRUE(writeModelToYaml(model, sequentialYaml));
+    ASSERT_TRUE(writeModelToYaml(parallelRadio.models[i], parallelYaml));
+    EXPECT_EQ(sequentialYaml, parallelYaml) << model.name;
+
+    EXPECT_STREQ(radio.models[models].name, model.name);
+    EXPECT_EQ(10 * (models + 1), model.mixData[0].weight);
+    models++;
+  }
+  EXPECT_EQ(count, models);
+}
@@ -371,9 +371,73 @@ void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
   strcat(str, SOUNDS_EXT);
 }
 
+// <name>-[on|off]: returns the event and removes the suffix, -1 otherwise
+static int stripAudioFileEvent(char * name, uint8_t * len)
+{
+  for (int event = 0; event < 2; event++) {
+    uint8_t suffix = strlen(suffixes[event]);
+    if (*len > suffix && !strcasecmp(name + *len - suffix, suffixes[event])) {
+      *len -= suffix;
+      name[*len] = '\0';
+      return event;
+    }
+  }
+  return -1;
+}
+
+// L<n>: logical switch index as in getLogicalSwitchAudioFile(), -1 otherwise
+static int getLogicalSwitchAudioFileIndex(const char * name, uint8_t len)
+{
+  if (len < 2 || len > 3 || (name[0] != 'L' && name[0] != 'l') || name[1] == '0')
+    return -1;
+
+  int index = 0;
+  for (uint8_t i = 1; i < len; i++) {
+    if (name[i] < '0' || name[i] > '9')
+      return -1;
+    index = index * 10 + name[i] - '0';
+  }
+
+  return index <= MAX_LOGICAL_SWITCHES ? index - 1 : -1;
+}
+
+// S<letter>-[up|mid|down] or S<pot><position>: switch position as in
+// getSwitchAudioFile(SWSRC_FIRST_SWITCH + position), -1 otherwise
+static int getSwitchAudioFileIndex(const char * name, uint8_t len)
+{
+  if (len < 3 || (name[0] != 'S' && name[0] != 's'))
+    return -1;
+
+  if (name[2] == '-') {
+    const char * positions[] = { "-up", "-mid", "-down" };
+    for (int pos = 0; pos < 3; pos++) {
+      if (strcasecmp(name + 2, positions[pos]))
+        continue;
+      uint8_t max_switches = switchGetMaxSwitches() + switchGetMaxFctSwitches();
+      for (uint8_t sw = 0; sw < max_switches && sw < MAX_SWITCHES; sw++) {
+        char letter = switchGetLetter(sw);
+        if (letter != (char)-1 && toupper(letter) == toupper(name[1]))
+          return sw * 3 + pos;
+      }
+    }
+    return -1;
+  }
+
+  if (len == 3 && name[1] >= '1' && name[1] <= '9' && name[2] >= '1' &&
+      name[2] < '1' + XPOTS_MULTIPOS_COUNT) {
+    int index = MAX_SWITCHES * 3 - 1 +
+                (name[1] - '1') * XPOTS_MULTIPOS_COUNT + (name[2] - '1');
+    if (index >= MAX_SWITCHES * 3 && index < (int)MAX_SWITCH_POSITIONS)
+      return index;
+  }
+
+  return -1;
+}
+
 void referenceModelAudioFiles()
 {
   char path[AUDIO_FILENAME_MAXLEN+1];
+  char flightModes[MAX_FLIGHT_MODES][LEN_FLIGHT_MODE_NAME+1];
   FILINFO fno;
   DIR dir;
 
@@ -384,6 +448,12 @@ void referenceModelAudioFiles()
   char * filename = getModelAudioPath(path);
   *(filename-1) = '\0';
 
+  // Each file name is parsed once instead of being compared with the names
+  // of all the flight modes, switch positions and logical switches
+  for (int i=0; i<MAX_FLIGHT_MODES; i++) {
+    *strcatFlightmodeName(flightModes[i], i) = '\0';
+  }
+
   FRESULT res = f_opendir(&dir, path);        /* Open the directory */
   if (res == FR_OK) {
     for (;;) {
@@ -396,42 +466,34 @@ void referenceModelAudioFiles()
       if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
       TRACE("referenceModelAudioFiles(): using file: %s", fno.fname);
 
-      // Flight modes Audio Files <flightmodename>-[on|off].wav
-      for (int i=0; i<MAX_FLIGHT_MODES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getFlightmodeAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
+      len -= 4;
+      fno.fname[len] = '\0';
+      int event = stripAudioFileEvent(fno.fname, &len);
+
+      if (event >= 0) {
+        // Flight modes Audio Files <flightmodename>-[on|off].wav
+        for (int i=0; i<MAX_FLIGHT_MODES; i++) {
+          if (!strcasecmp(flightModes[i], fno.fname)) {
             sdAvailableFlightmodeAudioFiles.setBit(INDEX_PHASE_AUDIO_FILE(i, event));
             found = true;
-            TRACE("\tfound: %s", filename);
+            TRACE("\tfound: flight mode %d", i);
             break;
           }
         }
-      }
 
-      // Switches Audio Files <switchname>-[up|mid|down].wav
-      for (unsigned i = 0; i <= MAX_SWITCH_POSITIONS && !found; i++) {
-        getSwitchAudioFile(path, i);
-        // TRACE("referenceModelAudioFiles(): searching for %s in %s (%d)", path, fno.fname, i);
-        if (!strcasecmp(filename, fno.fname)) {
-          sdAvailableSwitchAudioFiles.setBit(i);
-          found = true;
-          TRACE("\tfound: %s", filename);
+        // Logical Switches Audio Files <switchname>-[on|off].wav
+        int index = found ? -1 : getLogicalSwitchAudioFileIndex(fno.fname, len);
+        if (index >= 0) {
+          sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(index, event));
+          TRACE("\tfound: logical switch %d", index);
         }
       }
-
-      // Logical Switches Audio Files <switchname>-[on|off].wav
-      for (int i=0; i<MAX_LOGICAL_SWITCHES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getLogicalSwitchAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
+      else {
+        // Switches Audio Files <switchname>-[up|mid|down].wav
+        int index = getSwitchAudioFileIndex(fno.fname, len);
+        if (index >= 0) {
+          sdAvailableSwitchAudioFiles.setBit(index);
+          TRACE("\tfound: switch position %d", index);
         }
       }
     }
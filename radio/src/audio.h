@@ -653,6 +653,11 @@ void playModelName();
 #endif
 
 char * getAudioPath(char * path);
+char * getModelAudioPath(char * path);
+
+void getFlightmodeAudioFile(char * filename, int index, unsigned int event);
+void getSwitchAudioFile(char * filename, swsrc_t index);
+void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event);
 
 void referenceSystemAudioFiles();
 void referenceModelAudioFiles();
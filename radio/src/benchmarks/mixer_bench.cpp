@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+// Headless mixer benchmark: loads YAML models, drives the sticks, switches
+// and telemetry from a fixed script and times the mixer cycle.
+//
+//   mixer-bench [-n cycles] [-w warmup cycles] [-s] [model.yml ...]
+//
+// Without model arguments, all the models in BENCH_MODELS_PATH are used.
+// The channels checksum only depends on the script, so it can be compared
+// between two builds to make sure an optimization did not change outputs.
+//
+// With -s, the sources of the mix lines are also read through the
+// getValue(mixsrc_t) ranges and through their SourceRef on the same cycles,
+// and the run fails if they don't return the same values.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "opentx.h"
+#include "mixer_stats.h"
+#include "mixes.h"
+#include "sources.h"
+#include "hal/adc_driver.h"
+#include "hal/switch_driver.h"
+#include "telemetry/frsky_defs.h"
+
+#define BENCH_DEFAULT_CYCLES  20000
+#define BENCH_DEFAULT_WARMUP  1000
+#define BENCH_CYCLE_US        4000  // simulated mixer period
+#define BENCH_LOADS           20    // model loads timed
+
+extern const etx_hal_adc_driver_t simu_adc_driver;
+extern void anaResetFiltered();
+
+static uint32_t benchCycle = 0;
+
+// triangle wave in [-RESX, RESX], one period every 'period' cycles
+static int16_t benchTriangle(uint32_t cycle, uint32_t period)
+{
+  uint32_t pos = cycle % period;
+  uint32_t half = period / 2;
+  int32_t v = (pos < half ? pos : period - pos) * 2 * RESX / half;
+  return v - RESX;
+}
+
+uint16_t simu_get_analog(uint8_t idx)
+{
+  // each input gets its own period so that they are never in phase
+  return benchTriangle(benchCycle, 1000 + 250 * idx) * 2 + 2048;
+}
+
+static void benchSetInputs(uint32_t cycle)
+{
+  // switches go through all their positions, slower ones first
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    uint32_t period = 500 * (i + 1);
+    simuSetSwitch(i, (int8_t)((cycle / period) % 3) - 1);
+  }
+
+  // telemetry frame every 100ms
+  if (cycle % 25 == 0) {
+    int32_t v = benchTriangle(cycle, 2000);
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, RSSI_ID, 0, 0,
+                      70 + v / 64, UNIT_DB, 0);
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, BATT_ID, 0, 0,
+                      74 + v / 256, UNIT_VOLTS, 1);
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, ALT_FIRST_ID, 0, 0,
+                      5000 + v * 4, UNIT_METERS, 2);
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, VARIO_FIRST_ID, 0, 0,
+                      v / 2, UNIT_METERS_PER_SECOND, 2);
+  }
+
+  // the mixer only sees time through the 10ms tick
+  g_tmr10ms = 1 + cycle * BENCH_CYCLE_US / 10000;
+}
+
+// FNV-1a over all the output channels
+static uint32_t benchChecksum(uint32_t hash)
+{
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    uint16_t v = channelOutputs[i];
+    hash = (hash ^ (v & 0xFF)) * 16777619u;
+    hash = (hash ^ (v >> 8)) * 16777619u;
+  }
+  return hash;
+}
+
+static uint64_t benchNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static bool benchLoadModel(const std::string & path)
+{
+  std::string dir = ".";
+  std::string file = path;
+  size_t pos = path.rfind('/');
+  if (pos != std::string::npos) {
+    dir = path.substr(0, pos);
+    file = path.substr(pos + 1);
+  }
+
+  const char * error = loadModelTemplate(file.c_str(), dir.c_str());
+  if (error) {
+    fprintf(stderr, "%s: %s\n", path.c_str(), error);
+    return false;
+  }
+
+  memclear(channelOutputs, sizeof(channelOutputs));
+  memclear(chans, sizeof(chans));
+  memclear(ex_chans, sizeof(ex_chans));
+  anaResetFiltered();
+  flightReset(false);
+  return true;
+}
+
+// Returns the number of values different between getValue(mixsrc_t) and
+// getValue(const SourceRef &)
+static uint32_t benchSources(uint32_t cycles)
+{
+  mixsrc_t sources[MAX_MIXERS];
+  SourceRef refs[MAX_MIXERS];
+  getvalue_t ladderValues[MAX_MIXERS], refValues[MAX_MIXERS];
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    mixsrc_t src = mixAddress(i)->srcRaw;
+    if (src == 0)
+      continue;
+    sources[count] = src;
+    resolveSource(refs[count], src);
+    count++;
+  }
+  if (count == 0)
+    return 0;
+
+  uint64_t ladder = 0, ref = 0;
+  uint32_t mismatches = 0;
+
+  for (uint32_t i = 0; i < cycles; i++, benchCycle++) {
+    benchSetInputs(benchCycle);
+    doMixerCalculations();
+
+    uint64_t t0 = benchNow();
+    for (uint8_t l = 0; l < count; l++)
+      ladderValues[l] = getValue(sources[l]);
+    uint64_t t1 = benchNow();
+    for (uint8_t l = 0; l < count; l++)
+      refValues[l] = getValue(refs[l]);
+    uint64_t t2 = benchNow();
+
+    ladder += t1 - t0;
+    ref += t2 - t1;
+    for (uint8_t l = 0; l < count; l++) {
+      if (ladderValues[l] != refValues[l])
+        mismatches++;
+    }
+  }
+
+  printf("  sources   %u lines, getValue() %llu ns, SourceRef %llu ns\n", count,
+         (unsigned long long)(ladder / cycles), (unsigned long long)(ref / cycles));
+  printf("  mismatch  %u\n", mismatches);
+  return mismatches;
+}
+
+static bool benchRun(const std::string & path, uint32_t cycles,
+                     uint32_t warmup, bool sources)
+{
+  // model switch latency, the last load is the one used
+  uint64_t load = benchNow();
+  for (uint32_t i = 0; i < BENCH_LOADS; i++) {
+    if (!benchLoadModel(path))
+      return false;
+  }
+  load = (benchNow() - load) / BENCH_LOADS;
+
+  for (benchCycle = 0; benchCycle < warmup; benchCycle++) {
+    benchSetInputs(benchCycle);
+    doMixerCalculations();
+    pulsesSendChannels();
+  }
+
+  mixerStatsReset();
+
+  uint64_t stages[MIXER_STAGE_COUNT] = {0};
+  uint64_t total = 0, mixer = 0, longest = 0;
+  uint32_t checksum = 2166136261u;
+
+  for (uint32_t i = 0; i < cycles; i++, benchCycle++) {
+    benchSetInputs(benchCycle);
+
+    uint64_t t0 = benchNow();
+    doMixerCalculations();
+    uint64_t t1 = benchNow();
+    pulsesSendChannels();
+    uint64_t t2 = benchNow();
+
+    mixer += t1 - t0;
+    total += t2 - t0;
+    longest = std::max(longest, t2 - t0);
+    stages[MIXER_STAGE_PULSES] += t2 - t1;
+    for (uint8_t s = MIXER_STAGE_ADC; s <= MIXER_STAGE_MIXES; s++) {
+      stages[s] += mixerStats.stageLast[s] * 1000;
+    }
+
+    checksum = benchChecksum(checksum);
+  }
+
+  printf("%s\n", path.c_str());
+  printf("  load      %llu us\n", (unsigned long long)(load / 1000));
+  printf("  cycles    %u\n", cycles);
+  printf("  ns/cycle  %llu (mixer %llu, max %llu)\n",
+         (unsigned long long)(total / cycles),
+         (unsigned long long)(mixer / cycles), (unsigned long long)longest);
+  for (uint8_t s = MIXER_STAGE_ADC; s <= MIXER_STAGE_PULSES; s++) {
+    printf("  %-9s %llu\n", mixerStatsStageName(s),
+           (unsigned long long)(stages[s] / cycles));
+  }
+  printf("  checksum  %08x\n", checksum);
+
+  return !sources || benchSources(cycles) == 0;
+}
+
+static std::vector<std::string> benchListModels(const char * path)
+{
+  std::vector<std::string> models;
+  DIR dir;
+  if (f_opendir(&dir, path) != FR_OK) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return models;
+  }
+  FILINFO fno;
+  while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+    const char * ext = strrchr(fno.fname, '.');
+    if (ext && !strcmp(ext, YAML_EXT)) {
+      models.push_back(std::string(path) + "/" + fno.fname);
+    }
+  }
+  f_closedir(&dir);
+  std::sort(models.begin(), models.end());
+  return models;
+}
+
+int main(int argc, char ** argv)
+{
+  uint32_t cycles = BENCH_DEFAULT_CYCLES;
+  uint32_t warmup = BENCH_DEFAULT_WARMUP;
+  bool sources = false;
+  std::vector<std::string> models;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      cycles = atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+      warmup = atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "-s")) {
+      sources = true;
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "usage: %s [-n cycles] [-w warmup] [-s] [model.yml ...]\n",
+              argv[0]);
+      return 1;
+    }
+    else {
+      models.push_back(argv[i]);
+    }
+  }
+
+  // only the results on stdout, not the file accesses of each model load
+  traceOutput = false;
+
+  // model paths are host paths
+  simuFatfsSetPaths("", "");
+
+  if (models.empty()) {
+    models = benchListModels(BENCH_MODELS_PATH);
+  }
+  if (models.empty() || cycles == 0) {
+    return 1;
+  }
+
+  simuInit();
+  adcInit(&simu_adc_driver);
+  generalDefault();
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+
+  bool result = true;
+  for (const auto & model : models) {
+    result &= benchRun(model, cycles, warmup, sources);
+  }
+
+  return result ? 0 : 1;
+}
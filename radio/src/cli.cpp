@@ -37,6 +37,8 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "mixer_scheduler.h"
+#include "mixer_stats.h"
 
 #include "cli.h"
 
@@ -1387,6 +1389,13 @@ int cliDisplay(const char ** argv)
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
     cliSerialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    cliSerialPrint("  evictions: %u, read-ahead: %u (used %u)", stats.noEvictions, stats.noReadAheads, stats.noReadAheadHits);
+  }
+#endif
+#if defined(SDCARD)
+  else if (!strcmp(argv[1], "logs")) {
+    cliSerialPrint("Logs dropped rows: %u", logsDroppedRows);
+    cliSerialPrint("High rate logs rows: %u, dropped: %u", logsHighRateRows, logsHighRateDroppedRows);
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
@@ -1438,6 +1447,38 @@ int cliRepeat(const char ** argv)
 }
 #endif
 
+int cliMixerStats(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    mixerStatsReset();
+    return 0;
+  }
+  else if (argv[1][0] != '\0') {
+    cliSerialPrint("%s: Invalid arguments", argv[0]);
+    return -1;
+  }
+
+  cliSerialPrint("period %dus, %u cycles, %u overruns, jitter max %dus",
+                 getMixerSchedulerPeriod(), mixerStats.cycles,
+                 mixerStats.overruns, mixerStats.jitterMax);
+  cliSerialPrint("stage     last    max (us)");
+  for (int i = 0; i < MIXER_STAGE_COUNT; i++) {
+    cliSerialPrint("%-8s %5d  %5d", mixerStatsStageName(i),
+                   mixerStats.stageLast[i], mixerStats.stageMax[i]);
+  }
+  cliSerialPrint("< us        cycle     jitter");
+  for (int i = 0; i < MIXER_STATS_BUCKETS; i++) {
+    if (i < MIXER_STATS_BUCKETS - 1)
+      cliSerialPrint("%5d  %10u %10u", 1 << i, mixerStats.cycleHistogram[i],
+                     mixerStats.jitterHistogram[i]);
+    else
+      cliSerialPrint("  max  %10u %10u", mixerStats.cycleHistogram[i],
+                     mixerStats.jitterHistogram[i]);
+  }
+  cliSerialPrint("99%% of cycles < %uus", mixerStatsPercentile(mixerStats.cycleHistogram, 99));
+  return 0;
+}
+
 #if defined(JITTER_MEASURE)
 int cliShowJitter(const char ** argv)
 {
@@ -1633,6 +1674,7 @@ const CliCommand cliCommands[] = {
   { "repeat", cliRepeat, "<interval> <command>" },
 #endif
   { "help", cliHelp, "[<command>]" },
+  { "mixerstats", cliMixerStats, "[reset]" },
 #if defined(JITTER_MEASURE)
   { "jitter", cliShowJitter, "" },
 #endif
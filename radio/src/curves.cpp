@@ -19,6 +19,8 @@
  * GNU General Public License for more details.
  */
 
+#include <atomic>
+
 #include "opentx.h"
 
 #if defined(LIBOPENUI)
@@ -77,6 +79,7 @@ void loadCurves()
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired", "check your curves, logic switches");
   }
+  curvesCacheUpdate();
 }
 
 int8_t * curveAddress(uint8_t idx)
@@ -228,6 +231,150 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+// Smooth curves cache: the X position and the tangent of each point of the
+// first CURVE_CACHE_SIZE smooth curves, so that an evaluation only has to
+// find its segment. An entry holds a copy of the points it was computed
+// from and is only used while they match the model, so it is never stale.
+// curvesCacheUpdate() is the only writer, 'seq' is odd while it updates an
+// entry, readers then fall back to the uncached computation.
+struct CurveCacheEntry {
+  volatile uint8_t seq;
+  int8_t curve;
+  uint8_t type:1;
+  uint8_t count:7;
+  int8_t points[2 * MAX_POINTS_PER_CURVE - 2];
+  int16_t x[MAX_POINTS_PER_CURVE];
+  int32_t tangents[MAX_POINTS_PER_CURVE];
+};
+
+static CurveCacheEntry curveCache[CURVE_CACHE_SIZE];
+
+static int32_t hermite_point_x(const int8_t* points, uint8_t count, bool custom, int i)
+{
+  if (custom)
+    return i == 0 ? -RESX : (i == count - 1 ? RESX : calc100toRESX(points[count + i - 1]));
+  else
+    return -RESX + (i * 2 * RESX) / (count - 1);
+}
+
+static int16_t hermite_segment(int32_t x, int32_t p0x, int32_t p3x,
+                               int32_t p0y, int32_t p3y, int32_t m0, int32_t m3)
+{
+  int32_t y;
+  int32_t h = p3x - p0x;
+  int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
+  int32_t t2 = t * t / MMULT;
+  int32_t t3 = t2 * t / MMULT;
+  int32_t h00 = 2*t3 - 3*t2 + MMULT;
+  int32_t h10 = t3 - 2*t2 + t;
+  int32_t h01 = -2*t3 + 3*t2;
+  int32_t h11 = t3 - t2;
+  y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
+  y /= MMULT;
+  return y;
+}
+
+static bool curveCacheMatch(const CurveCacheEntry& entry, uint8_t idx)
+{
+  const CurveHeader& crv = g_model.curves[idx];
+  return crv.smooth && entry.type == crv.type &&
+         entry.count == STD_CURVE_POINTS(crv.points) &&
+         !memcmp(entry.points, curveAddress(idx), getCurvePoints(idx));
+}
+
+static bool hermite_spline_cached(int16_t x, uint8_t idx, int16_t& y)
+{
+  for (const auto& entry : curveCache) {
+    uint8_t seq = entry.seq;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    if (entry.curve != idx || (seq & 1) || !curveCacheMatch(entry, idx))
+      continue;
+
+    // the X positions are sorted, find the first segment ending after x
+    int lo = 0, hi = entry.count - 2;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (entry.x[mid + 1] >= x)
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+
+    int32_t p0x = entry.x[lo], p3x = entry.x[lo + 1];
+    int32_t p0y = calc100toRESX(entry.points[lo]);
+    int32_t p3y = calc100toRESX(entry.points[lo + 1]);
+    int32_t m0 = entry.tangents[lo], m3 = entry.tangents[lo + 1];
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    if (entry.seq != seq)
+      return false;
+
+    y = hermite_segment(x, p0x, p3x, p0y, p3y, m0, m3);
+    return true;
+  }
+  return false;
+}
+
+void curvesCacheUpdate()
+{
+  uint8_t slot = 0;
+  for (uint8_t idx = 0; idx < MAX_CURVES && slot < CURVE_CACHE_SIZE; idx++) {
+    CurveHeader& crv = g_model.curves[idx];
+    if (!crv.smooth)
+      continue;
+
+    int8_t* points = curveAddress(idx);
+    uint8_t count = STD_CURVE_POINTS(crv.points);
+    bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+
+    // the segments search needs X values in ascending order
+    bool sorted = true;
+    for (int i = 0; i < count - 1; i++) {
+      if (hermite_point_x(points, count, custom, i) >
+          hermite_point_x(points, count, custom, i + 1))
+        sorted = false;
+    }
+    if (!sorted)
+      continue;
+
+    CurveCacheEntry& entry = curveCache[slot++];
+    if (entry.curve == idx && curveCacheMatch(entry, idx))
+      continue;
+
+    entry.seq++;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    entry.curve = idx;
+    entry.type = crv.type;
+    entry.count = count;
+    memcpy(entry.points, points, getCurvePoints(idx));
+    for (int i = 0; i < count; i++) {
+      entry.x[i] = hermite_point_x(entry.points, count, custom, i);
+      entry.tangents[i] = compute_tangent(&crv, entry.points, i);
+    }
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    entry.seq++;
+  }
+
+  while (slot < CURVE_CACHE_SIZE) {
+    CurveCacheEntry& entry = curveCache[slot++];
+    if (entry.curve >= 0) {
+      entry.seq++;
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      entry.curve = -1;
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      entry.seq++;
+    }
+  }
+}
+
+bool isCurveCached(uint8_t index)
+{
+  for (const auto& entry : curveCache) {
+    if (entry.curve == index && !(entry.seq & 1))
+      return curveCacheMatch(entry, index);
+  }
+  return false;
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -245,34 +392,20 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   else if (x > RESX)
     x = RESX;
 
+  int16_t y;
+  if (hermite_spline_cached(x, idx, y))
+    return y;
+
   for (int i=0; i<count-1; i++) {
-    int32_t p0x, p3x;
-    if (custom) {
-      p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
-      p3x = (i<count-2 ? calc100toRESX(points[count+i]) : RESX);
-    }
-    else {
-      p0x = -RESX + (i*2*RESX)/(count-1);
-      p3x = -RESX + ((i+1)*2*RESX)/(count-1);
-    }
+    int32_t p0x = hermite_point_x(points, count, custom, i);
+    int32_t p3x = hermite_point_x(points, count, custom, i+1);
 
     if (x >= p0x && x <= p3x) {
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
       int32_t m0 = compute_tangent(&crv, points, i);
       int32_t m3 = compute_tangent(&crv, points, i+1);
-      int32_t y;
-      int32_t h = p3x - p0x;
-      int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
-      int32_t t2 = t * t / MMULT;
-      int32_t t3 = t2 * t / MMULT;
-      int32_t h00 = 2*t3 - 3*t2 + MMULT;
-      int32_t h10 = t3 - 2*t2 + t;
-      int32_t h01 = -2*t3 + 3*t2;
-      int32_t h11 = t3 - t2;
-      y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
-      y /= MMULT;
-      return y;
+      return hermite_segment(x, p0x, p3x, p0y, p3y, m0, m3);
     }
   }
   return 0;
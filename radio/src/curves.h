@@ -22,6 +22,13 @@
 #ifndef _CURVES_H_
 #define _CURVES_H_
 
+// number of smooth curves whose tangents are cached
+#if defined(COLORLCD)
+  #define CURVE_CACHE_SIZE  8
+#else
+  #define CURVE_CACHE_SIZE  4
+#endif
+
 enum BaseCurves {
   CURVE_NONE,
   CURVE_X_GT0,
@@ -36,7 +43,9 @@ enum BaseCurves {
 void curveClear(uint8_t index);
 void curveMirror(uint8_t index);
 bool isCurveUsed(uint8_t index);
+bool isCurveCached(uint8_t index);
 void loadCurves();
+void curvesCacheUpdate();
 int8_t * curveAddress(uint8_t idx);
 bool moveCurve(uint8_t index, int8_t shift);
 int8_t getCurveX(int noPoints, int point);
@@ -25,6 +25,7 @@
 
 #if defined(SIMU)
 traceCallbackFunc traceCallback = 0;
+bool traceOutput = true;
 #endif
 
 #if defined(SIMU)
@@ -37,8 +38,10 @@ void debugPrintf(const char * format, ...)
   va_start(arglist, format);
   vsnprintf(tmp, PRINTF_BUFFER_SIZE, format, arglist);
   va_end(arglist);
-  fputs(tmp, stdout);
-  fflush(stdout);
+  if (traceOutput) {
+    fputs(tmp, stdout);
+    fflush(stdout);
+  }
   if (traceCallback) {
     traceCallback(tmp);
   }
@@ -172,6 +175,7 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"Mix getsw  "   // debugTimerGetSwitches
   ,"Mix eval   "   // debugTimerEvalMixes
   ,"Mix 10ms   "   // debugTimerMixes10ms
+  ,"Mix fade   "   // debugTimerMixFade
   ,"ADC read   "   // debugTimerAdcRead
   ,"mix-pulses "   // debugTimerMixerCalcToUsage
   ,"mix-int.   "   // debugTimerMixerIterval
@@ -36,6 +36,7 @@ EXTERN_C(extern volatile uint32_t g_tmr10ms);
 #if defined(SIMU)
   typedef void (*traceCallbackFunc)(const char * text);
   extern traceCallbackFunc traceCallback;
+  extern bool traceOutput;  // traces printed on stdout
   EXTERN_C(void debugPrintf(const char * format, ...));
 #elif defined(SEMIHOSTING)
   #include <stdio.h>
@@ -380,6 +381,7 @@ enum DebugTimers {
   debugTimerGetSwitches,
   debugTimerEvalMixes,
   debugTimerMixes10ms,
+  debugTimerMixFade,
 
   debugTimerAdcRead,
 
@@ -23,6 +23,7 @@
 #include "sdcard.h"
 
 #include <string.h>
+#include <algorithm>
 
 #if 0  // set to 1 to enable traces
   #include "debug.h"
@@ -37,155 +38,492 @@
 
 #define BLOCK_SIZE FF_MAX_SS
 #define DISK_CACHE_BLOCK_SIZE (DISK_CACHE_BLOCK_SECTORS * BLOCK_SIZE)
+#define DISK_CACHE_HASH_SIZE  (DISK_CACHE_BLOCKS_NUM * 2)
+#define NO_BLOCK              0xFF
+#define NO_SECTOR             ((DWORD)-1)
+
+// the probation segment keeps at least a quarter of the blocks
+#define PROTECTED_BLOCKS_MAX  (DISK_CACHE_BLOCKS_NUM * 3 / 4)
+
+static_assert(DISK_CACHE_BLOCKS_NUM < NO_BLOCK, "Too many disk cache blocks");
+static_assert(DISK_CACHE_READ_AHEAD >= 1 &&
+              DISK_CACHE_READ_AHEAD <= DISK_CACHE_BLOCKS_NUM - PROTECTED_BLOCKS_MAX,
+              "Read ahead larger than the probation segment");
+
+enum DiskCacheSegment {
+  SEGMENT_FREE,
+  SEGMENT_PROBATION,
+  SEGMENT_PROTECTED,
+};
 
 DiskCache diskCache;
 
-class DiskCacheBlock
+struct DiskCacheBlock
 {
- public:
-  DiskCacheBlock();
-  bool read(BYTE* buff, DWORD sector, UINT count);
-  DRESULT fill(const diskio_driver_t* drv, BYTE lun, BYTE* buff, DWORD sector,
-               UINT count);
-  void free(DWORD sector, UINT count);
-  void free();
-  bool empty() const;
-
- private:
   uint8_t data[DISK_CACHE_BLOCK_SIZE];
   DWORD startSector;
-  DWORD endSector;
+  uint8_t sectors;   // less than a block at the end of the disk
+  uint8_t segment;
+  uint8_t prev;      // towards the most recently used block
+  uint8_t next;
+  uint8_t hashNext;
+  bool readAhead;    // filled ahead and not read yet
 };
 
-DiskCacheBlock::DiskCacheBlock():
-  startSector(0),
-  endSector(0) 
+static inline uint8_t hashIndex(DWORD startSector)
+{
+  return (startSector / DISK_CACHE_BLOCK_SECTORS) % DISK_CACHE_HASH_SIZE;
+}
+
+DiskCache::DiskCache() :
+  blocks(nullptr),
+  readAheadBuffer(nullptr),
+  diskDrv(nullptr),
+  sectors(0),
+  nextSector(NO_SECTOR),
+  protectedBlocks(0),
+  writeBack(false),
+  dirtyLun(0),
+  dirtyCount(0),
+  dirtyData(nullptr)
 {
+  memset(&stats, 0, sizeof(stats));
 }
 
-bool DiskCacheBlock::read(BYTE * buff, DWORD sector, UINT count)
+DiskCache::~DiskCache()
 {
-  if (sector >= startSector && (sector+count) <= endSector) {
-    TRACE_DISK_CACHE("\tcache read(%u, %u) from %p", (uint32_t)sector, (uint32_t)count, this);
-    memcpy(buff, data + ((sector - startSector) * BLOCK_SIZE), count * BLOCK_SIZE);
-    return true;
+  delete[] blocks;
+  delete[] readAheadBuffer;
+  delete[] dirtyData;
+}
+
+void DiskCache::initialize(const diskio_driver_t* drv)
+{
+  if (!blocks) {
+    blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
   }
-  return false;
+  if (DISK_CACHE_READ_AHEAD > 1 && !readAheadBuffer) {
+    readAheadBuffer = new uint8_t[DISK_CACHE_READ_AHEAD * DISK_CACHE_BLOCK_SIZE];
+  }
+  diskDrv = drv;
+  clear();
+#if defined(DISK_CACHE_WRITE_BACK)
+  setWriteBack(true);
+#endif
 }
 
-DRESULT DiskCacheBlock::fill(const diskio_driver_t* drv, BYTE lun, BYTE * buff,
-			     DWORD sector, UINT count)
+void DiskCache::setWriteBack(bool enabled)
 {
-  DRESULT res = drv->read(lun, data, sector, DISK_CACHE_BLOCK_SECTORS);
-  if (res != RES_OK) {
-    return res;
+  if (enabled && !dirtyData) {
+    dirtyData = new uint8_t[DISK_CACHE_WRITE_SECTORS * BLOCK_SIZE];
   }
-  startSector = sector;
-  endSector = sector + DISK_CACHE_BLOCK_SECTORS;
-  memcpy(buff, data, count * BLOCK_SIZE);
-  TRACE_DISK_CACHE("cache %p FILLED from read(%u, %u)", this, (uint32_t)sector, (uint32_t)count);
-  return RES_OK;
+  else if (!enabled) {
+    flush();
+  }
+  writeBack = enabled;
 }
 
-void DiskCacheBlock::free(DWORD sector, UINT count) 
+void DiskCache::clear()
 {
-  if (sector < endSector && (sector+count) > startSector) {
-    TRACE_DISK_CACHE("\tINVALIDATING disk cache block %p (%u)", this, startSector);
-    endSector = 0;
+  memset(&stats, 0, sizeof(stats));
+  sectors = 0;  // the card may have been changed
+  nextSector = NO_SECTOR;
+  protectedBlocks = 0;
+  // pending writes were for the previous card, unmounting flushes them
+  dirtyCount = 0;
+  memset(hash, NO_BLOCK, sizeof(hash));
+  memset(head, NO_BLOCK, sizeof(head));
+  memset(tail, NO_BLOCK, sizeof(tail));
+  if (!blocks) {
+    return;
+  }
+  for (uint8_t n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+    pushFront(n, SEGMENT_FREE);
   }
 }
 
-void DiskCacheBlock::free()
+uint32_t DiskCache::getSectors(uint8_t lun)
 {
-  endSector = 0;
+  if (sectors == 0) {
+    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
+  }
+  return sectors;
 }
 
-bool DiskCacheBlock::empty() const
+uint8_t DiskCache::find(DWORD startSector) const
 {
-  return (endSector == 0);
+  uint8_t idx = hash[hashIndex(startSector)];
+  while (idx != NO_BLOCK && blocks[idx].startSector != startSector) {
+    idx = blocks[idx].hashNext;
+  }
+  return idx;
 }
 
-DiskCache::DiskCache() : lastBlock(0), blocks(nullptr), diskDrv(nullptr)
+void DiskCache::unlink(uint8_t idx)
 {
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  DiskCacheBlock& block = blocks[idx];
+  if (block.prev != NO_BLOCK)
+    blocks[block.prev].next = block.next;
+  else
+    head[block.segment] = block.next;
+  if (block.next != NO_BLOCK)
+    blocks[block.next].prev = block.prev;
+  else
+    tail[block.segment] = block.prev;
+  if (block.segment == SEGMENT_PROTECTED) {
+    protectedBlocks--;
+  }
 }
 
-void DiskCache::initialize(const diskio_driver_t* drv)
+void DiskCache::pushFront(uint8_t idx, uint8_t segment)
 {
-  blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
-  diskDrv = drv;
+  DiskCacheBlock& block = blocks[idx];
+  block.segment = segment;
+  block.prev = NO_BLOCK;
+  block.next = head[segment];
+  if (head[segment] != NO_BLOCK)
+    blocks[head[segment]].prev = idx;
+  else
+    tail[segment] = idx;
+  head[segment] = idx;
+  if (segment == SEGMENT_PROTECTED) {
+    protectedBlocks++;
+  }
 }
 
-void DiskCache::clear()
+// removes a used block from the index and frees it
+void DiskCache::remove(uint8_t idx)
 {
-  lastBlock = 0;
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free();
+  TRACE_DISK_CACHE("\tINVALIDATING disk cache block %u (%u)", idx,
+                   (uint32_t)blocks[idx].startSector);
+  uint8_t* p = &hash[hashIndex(blocks[idx].startSector)];
+  while (*p != idx) {
+    p = &blocks[*p].hashNext;
   }
+  *p = blocks[idx].hashNext;
+  unlink(idx);
+  pushFront(idx, SEGMENT_FREE);
 }
 
-uint32_t DiskCache::getSectors(uint8_t lun)
+// a block read again by a new request is protected, a block read again
+// by the same sequential read only moves up in its own segment
+void DiskCache::touch(uint8_t idx, bool promote)
 {
-  if (sectors == 0) {
-    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
+  uint8_t segment = promote ? SEGMENT_PROTECTED : blocks[idx].segment;
+  unlink(idx);
+  pushFront(idx, segment);
+
+  if (protectedBlocks > PROTECTED_BLOCKS_MAX) {
+    uint8_t last = tail[SEGMENT_PROTECTED];
+    unlink(last);
+    pushFront(last, SEGMENT_PROBATION);
   }
-  return sectors;
 }
 
-DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
+uint8_t DiskCache::allocate(DWORD startSector, uint8_t count)
 {
-  // if read is bigger than cache block, then read it directly without using cache
-  if (count > DISK_CACHE_BLOCK_SECTORS) {
-    TRACE_DISK_CACHE("big read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
-    return diskDrv->read(lun, buff, sector, count);
+  uint8_t idx = head[SEGMENT_FREE];
+  if (idx == NO_BLOCK) {
+    idx = tail[SEGMENT_PROBATION];
+    if (idx == NO_BLOCK) {
+      idx = tail[SEGMENT_PROTECTED];
+    }
+    remove(idx);
+    ++stats.noEvictions;
   }
-  
-  // if block + cache block size is beyond the end of the disk,
-  // then read it directly without using cache
-  if (sector + DISK_CACHE_BLOCK_SECTORS >= getSectors(lun)) {
-    TRACE_DISK_CACHE("cache would be beyond end of disk %u (%u)",
-		     (uint32_t)sector, getSectors(lun));
-    return diskDrv->read(lun, buff, sector, count);
+
+  DiskCacheBlock& block = blocks[idx];
+  unlink(idx);
+  block.startSector = startSector;
+  block.sectors = count;
+  block.readAhead = false;
+  uint8_t h = hashIndex(startSector);
+  block.hashNext = hash[h];
+  hash[h] = idx;
+  pushFront(idx, SEGMENT_PROBATION);
+  return idx;
+}
+
+// index of the first write-back sector not below 'sector'
+uint8_t DiskCache::findDirty(DWORD sector) const
+{
+  uint8_t first = 0;
+  uint8_t last = dirtyCount;
+  while (first < last) {
+    uint8_t middle = (first + last) / 2;
+    if (dirtySectors[middle] < sector)
+      first = middle + 1;
+    else
+      last = middle;
   }
+  return first;
+}
 
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].read(buff, sector, count)) {
-      ++stats.noHits;
-      return RES_OK;
+void DiskCache::addDirty(const BYTE* buff, DWORD sector)
+{
+  uint8_t pos = findDirty(sector);
+  if (pos == dirtyCount || dirtySectors[pos] != sector) {
+    memmove(&dirtySectors[pos + 1], &dirtySectors[pos],
+            (dirtyCount - pos) * sizeof(DWORD));
+    memmove(dirtyData + (pos + 1) * BLOCK_SIZE, dirtyData + pos * BLOCK_SIZE,
+            (dirtyCount - pos) * BLOCK_SIZE);
+    dirtySectors[pos] = sector;
+    dirtyCount++;
+  }
+  memcpy(dirtyData + pos * BLOCK_SIZE, buff, BLOCK_SIZE);
+}
+
+void DiskCache::dropDirty(DWORD sector, UINT count)
+{
+  uint8_t first = findDirty(sector);
+  uint8_t last = findDirty(sector + count);
+  if (first == last) {
+    return;
+  }
+  memmove(&dirtySectors[first], &dirtySectors[last],
+          (dirtyCount - last) * sizeof(DWORD));
+  memmove(dirtyData + first * BLOCK_SIZE, dirtyData + last * BLOCK_SIZE,
+          (dirtyCount - last) * BLOCK_SIZE);
+  dirtyCount -= last - first;
+}
+
+// driver read, with the write-back sectors not written yet
+DRESULT DiskCache::diskRead(BYTE lun, BYTE* buff, DWORD sector, UINT count)
+{
+  DRESULT res = diskDrv->read(lun, buff, sector, count);
+  if (res == RES_OK) {
+    for (uint8_t n = findDirty(sector);
+         n < dirtyCount && dirtySectors[n] < sector + count; n++) {
+      memcpy(buff + (dirtySectors[n] - sector) * BLOCK_SIZE,
+             dirtyData + n * BLOCK_SIZE, BLOCK_SIZE);
+    }
+  }
+  return res;
+}
+
+DRESULT DiskCache::flush()
+{
+  DRESULT res = RES_OK;
+  uint8_t n = 0;
+
+  // adjacent sectors are written in one request
+  while (n < dirtyCount) {
+    uint8_t run = 1;
+    while (n + run < dirtyCount &&
+           dirtySectors[n + run] == dirtySectors[n] + run) {
+      run++;
     }
+    TRACE_DISK_CACHE("flush(%u, %u)", (uint32_t)dirtySectors[n], run);
+    res = diskDrv->write(dirtyLun, dirtyData + n * BLOCK_SIZE, dirtySectors[n], run);
+    if (res != RES_OK) {
+      break;
+    }
+    ++stats.noFlushWrites;
+    stats.noFlushSectors += run;
+    n += run;
+  }
+
+  // the sectors not written are kept for the next flush
+  if (n > 0) {
+    memmove(dirtySectors, &dirtySectors[n], (dirtyCount - n) * sizeof(DWORD));
+    memmove(dirtyData, dirtyData + n * BLOCK_SIZE, (dirtyCount - n) * BLOCK_SIZE);
+    dirtyCount -= n;
   }
 
-  ++stats.noMisses;
+  return res;
+}
+
+// reads blocksNum consecutive blocks, none of them already cached,
+// in one driver request
+DRESULT DiskCache::fill(BYTE lun, DWORD startSector, UINT blocksNum)
+{
+  UINT count = std::min<DWORD>(blocksNum * DISK_CACHE_BLOCK_SECTORS,
+                               getSectors(lun) - startSector);
+
+  if (blocksNum == 1) {
+    uint8_t idx = allocate(startSector, count);
+    DRESULT res = diskRead(lun, blocks[idx].data, startSector, count);
+    if (res != RES_OK) {
+      remove(idx);
+    }
+    TRACE_DISK_CACHE("cache %u FILLED from read(%u, %u)", idx,
+                     (uint32_t)startSector, count);
+    return res;
+  }
+
+  DRESULT res = diskRead(lun, readAheadBuffer, startSector, count);
+  if (res != RES_OK) {
+    return res;
+  }
+
+  TRACE_DISK_CACHE("cache FILLED from read-ahead(%u, %u)",
+                   (uint32_t)startSector, count);
+
+  // the requested block last, so that it is the most recently used
+  for (int n = blocksNum - 1; n >= 0; n--) {
+    UINT offset = n * DISK_CACHE_BLOCK_SECTORS;
+    UINT sectorsNum = std::min<UINT>(DISK_CACHE_BLOCK_SECTORS, count - offset);
+    uint8_t idx = allocate(startSector + offset, sectorsNum);
+    memcpy(blocks[idx].data, readAheadBuffer + offset * BLOCK_SIZE,
+           sectorsNum * BLOCK_SIZE);
+    if (n > 0) {
+      blocks[idx].readAhead = true;
+      ++stats.noReadAheads;
+    }
+  }
+  return RES_OK;
+}
+
+DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
+{
+  DWORD total = getSectors(lun);
+  if (sector + count > total) {
+    return diskRead(lun, buff, sector, count);
+  }
+
+  bool sequential = (sector == nextSector);
+  bool bigRead = (count > DISK_CACHE_BLOCK_SECTORS);
+  nextSector = sector + count;
+
+  while (count > 0) {
+    DWORD startSector = sector - sector % DISK_CACHE_BLOCK_SECTORS;
+    UINT offset = sector - startSector;
+    UINT sectorsNum = std::min<UINT>(count, DISK_CACHE_BLOCK_SECTORS - offset);
+    uint8_t idx = find(startSector);
+
+    if (idx == NO_BLOCK && bigRead) {
+      // the blocks not cached are read directly, in as few requests as
+      // possible, big reads are mostly read once
+      UINT run = sectorsNum;
+      UINT blocksNum = 1;
+      while (run < count && find(sector + run) == NO_BLOCK) {
+        run += std::min<UINT>(count - run, DISK_CACHE_BLOCK_SECTORS);
+        blocksNum++;
+      }
+      TRACE_DISK_CACHE("big read(%u, %u)", (uint32_t)sector, run);
+      DRESULT res = diskRead(lun, buff, sector, run);
+      if (res != RES_OK) {
+        return res;
+      }
+      stats.noMisses += blocksNum;
+      buff += run * BLOCK_SIZE;
+      sector += run;
+      count -= run;
+      continue;
+    }
 
-  // find free block
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].empty()) {
-      TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(diskDrv, lun, buff, sector, count);
+    if (idx == NO_BLOCK) {
+      ++stats.noMisses;
+      UINT blocksNum = 1;
+      if (sequential) {
+        while (blocksNum < DISK_CACHE_READ_AHEAD) {
+          DWORD next = startSector + blocksNum * DISK_CACHE_BLOCK_SECTORS;
+          if (next >= total || find(next) != NO_BLOCK)
+            break;
+          blocksNum++;
+        }
+      }
+      DRESULT res = fill(lun, startSector, blocksNum);
+      if (res != RES_OK) {
+        return res;
+      }
+      idx = head[SEGMENT_PROBATION];
+    }
+    else {
+      ++stats.noHits;
+      if (blocks[idx].readAhead) {
+        blocks[idx].readAhead = false;
+        ++stats.noReadAheadHits;
+      }
+      touch(idx, !sequential);
     }
+
+    TRACE_DISK_CACHE("\tcache read(%u, %u) from %u", (uint32_t)sector,
+                     sectorsNum, idx);
+    memcpy(buff, blocks[idx].data + offset * BLOCK_SIZE,
+           sectorsNum * BLOCK_SIZE);
+    buff += sectorsNum * BLOCK_SIZE;
+    sector += sectorsNum;
+    count -= sectorsNum;
   }
 
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
+  return RES_OK;
+}
+
+// keeps the cached copy in line with the disk, or drops it if the write failed
+void DiskCache::update(uint8_t idx, const BYTE* buff, DWORD sector, UINT count,
+                       bool written)
+{
+  DiskCacheBlock& block = blocks[idx];
+  DWORD first = std::max<DWORD>(sector, block.startSector);
+  DWORD last = std::min<DWORD>(sector + count, block.startSector + block.sectors);
+  if (first >= last) {
+    return;
+  }
+
+  if (written) {
+    memcpy(block.data + (first - block.startSector) * BLOCK_SIZE,
+           buff + (first - sector) * BLOCK_SIZE, (last - first) * BLOCK_SIZE);
+  }
+  else {
+    remove(idx);
   }
-  
-  return blocks[lastBlock].fill(diskDrv, lun, buff, sector, count);
 }
 
 DRESULT DiskCache::write(BYTE lun, const BYTE* buff, DWORD sector, UINT count)
 {
   ++stats.noWrites;
-  for(int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free(sector, count);
+
+  DRESULT res = RES_OK;
+  if (writeBack && count <= DISK_CACHE_WRITE_SECTORS / 2) {
+    if (dirtyCount + count > DISK_CACHE_WRITE_SECTORS) {
+      res = flush();
+    }
+    if (res == RES_OK) {
+      dirtyLun = lun;
+      for (UINT n = 0; n < count; n++) {
+        addDirty(buff + n * BLOCK_SIZE, sector + n);
+      }
+    }
   }
-  return diskDrv->write(lun, buff, sector, count);
+  else {
+    res = diskDrv->write(lun, buff, sector, count);
+    if (res == RES_OK) {
+      // older data for the same sectors must not be written afterwards
+      dropDirty(sector, count);
+    }
+  }
+
+  if (count > DISK_CACHE_BLOCKS_NUM * DISK_CACHE_BLOCK_SECTORS) {
+    for (uint8_t n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+      if (blocks[n].segment != SEGMENT_FREE) {
+        update(n, buff, sector, count, res == RES_OK);
+      }
+    }
+  }
+  else {
+    DWORD end = sector + count;
+    for (DWORD startSector = sector - sector % DISK_CACHE_BLOCK_SECTORS;
+         startSector < end; startSector += DISK_CACHE_BLOCK_SECTORS) {
+      uint8_t idx = find(startSector);
+      if (idx != NO_BLOCK) {
+        update(idx, buff, sector, count, res == RES_OK);
+      }
+    }
+  }
+
+  return res;
+}
+
+DRESULT DiskCache::ioctl(BYTE lun, BYTE cmd, void* buff)
+{
+  if (cmd == CTRL_SYNC) {
+    DRESULT res = flush();
+    if (res != RES_OK) {
+      return res;
+    }
+  }
+  return diskDrv->ioctl(lun, cmd, buff);
 }
 
 const DiskCacheStats & DiskCache::getStats() const 
@@ -210,3 +548,7 @@ DRESULT disk_cache_write(BYTE drv, const BYTE * buff, DWORD sector, UINT count)
   return diskCache.write(drv, buff, sector, count);
 }
 
+DRESULT disk_cache_ioctl(BYTE drv, BYTE cmd, void * buff)
+{
+  return diskCache.ioctl(drv, cmd, buff);
+}
@@ -26,43 +26,104 @@
 // tunable parameters
 #define DISK_CACHE_BLOCKS_NUM      32   // no cache blocks
 #define DISK_CACHE_BLOCK_SECTORS   16   // no sectors
+#define DISK_CACHE_READ_AHEAD      2    // no blocks read at once on sequential misses
+#define DISK_CACHE_WRITE_SECTORS   32   // no sectors held by the write-back buffer
+
+// Blocks are aligned on DISK_CACHE_BLOCK_SECTORS and replaced with a
+// segmented LRU: a block read once sits in the probation segment, it is
+// promoted to the protected segment when it is read again, so that a long
+// sequential read cannot flush the FAT and directory blocks.
+//
+// In write-back mode (DISK_CACHE_WRITE_BACK, or setWriteBack() at run time),
+// small writes are kept in RAM, sorted by sector, and adjacent sectors are
+// written together in one driver request when the buffer is flushed:
+//  - on CTRL_SYNC, i.e. when f_sync() or f_close() is called
+//  - when the card is unmounted, which is done before the USB mass storage
+//    mode is entered and at power off
+//  - when the buffer is full
+// Reads through the cache always return the last data written. After f_sync()
+// or f_close() has returned without error, the data is on the card. Writes
+// made since the last flush are lost on a power failure, and the sectors are
+// written in sector order, not in the order FatFs wrote them. When a flush
+// fails, the sectors not written are kept and the error is returned.
 
 struct DiskCacheStats
 {
-  uint32_t noHits;
-  uint32_t noMisses;
+  uint32_t noHits;           // blocks found in the cache
+  uint32_t noMisses;         // blocks read from the disk
   uint32_t noWrites;
+  uint32_t noEvictions;      // blocks replaced by another one
+  uint32_t noReadAheads;     // blocks read ahead of a sequential read
+  uint32_t noReadAheadHits;  // read ahead blocks used afterwards
+  uint32_t noFlushWrites;    // driver requests made by write-back flushes
+  uint32_t noFlushSectors;   // sectors written by write-back flushes
 };
 
-class DiskCacheBlock;
+struct DiskCacheBlock;
 
 class DiskCache
 {
  public:
   DiskCache();
+  ~DiskCache();
 
   void initialize(const diskio_driver_t* drv);
   void clear();
 
   DRESULT read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
   DRESULT write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
+  DRESULT ioctl(BYTE drv, BYTE cmd, void* buff);
+
+  // writes the pending write-back sectors
+  DRESULT flush();
+  void setWriteBack(bool enabled);
+  bool isWriteBack() const { return writeBack; }
+  uint32_t getDirtySectors() const { return dirtyCount; }
 
   const DiskCacheStats& getStats() const;
   int getHitRate() const;
 
  private:
   DiskCacheStats stats;
-  uint32_t lastBlock;
   DiskCacheBlock* blocks;
+  uint8_t* readAheadBuffer;
   const diskio_driver_t* diskDrv;
   uint32_t sectors;
+  DWORD nextSector;  // sector following the previous read
+
+  // first block of each hash chain, indexed by block number
+  uint8_t hash[DISK_CACHE_BLOCKS_NUM * 2];
+  // most and least recently used blocks of each segment
+  uint8_t head[3];
+  uint8_t tail[3];
+  uint8_t protectedBlocks;
+
+  // write-back sectors, sorted
+  bool writeBack;
+  BYTE dirtyLun;
+  uint8_t dirtyCount;
+  DWORD dirtySectors[DISK_CACHE_WRITE_SECTORS];
+  uint8_t* dirtyData;
 
   uint32_t getSectors(uint8_t lun);
+  uint8_t find(DWORD startSector) const;
+  void unlink(uint8_t idx);
+  void pushFront(uint8_t idx, uint8_t segment);
+  void remove(uint8_t idx);
+  void touch(uint8_t idx, bool promote);
+  uint8_t allocate(DWORD startSector, uint8_t count);
+  void update(uint8_t idx, const BYTE* buff, DWORD sector, UINT count,
+              bool written);
+  DRESULT fill(BYTE lun, DWORD startSector, UINT blocksNum);
+  DRESULT diskRead(BYTE lun, BYTE* buff, DWORD sector, UINT count);
+  uint8_t findDirty(DWORD sector) const;
+  void addDirty(const BYTE* buff, DWORD sector);
+  void dropDirty(DWORD sector, UINT count);
 };
 
 extern DiskCache diskCache;
 
 DRESULT disk_cache_read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_cache_write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
-
+DRESULT disk_cache_ioctl(BYTE drv, BYTE cmd, void* buff);
 
@@ -129,6 +129,57 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
 #define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
 getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
 
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+static bool safetyChSet = true;  // some safetyCh[] not reset yet
+#endif
+
+#if defined(GVARS)
+static bool trimGvarSet = true;  // some trimGvar[] not reset yet
+#endif
+
+static inline uint16_t getFunctionKey(const CustomFunctionData * cfn)
+{
+  return (CFN_SWITCH(cfn) & 0x3FF) | (CFN_FUNC(cfn) << 10);
+}
+
+static inline uint8_t getFunctionSwitchFlags(const CustomFunctionData * cfn)
+{
+  return IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0;
+}
+
+static bool isFunctionsPlanValid(const CustomFunctionData * functions,
+                                 const CustomFunctionsPlan & plan)
+{
+  for (uint8_t i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    if (getFunctionKey(&functions[i]) != plan.keys[i]) return false;
+  }
+  return true;
+}
+
+static void buildFunctionsPlan(const CustomFunctionData * functions,
+                               CustomFunctionsPlan & plan)
+{
+  plan.count = 0;
+
+  for (uint8_t i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    const CustomFunctionData * cfn = &functions[i];
+    plan.keys[i] = getFunctionKey(cfn);
+    if (!CFN_SWITCH(cfn)) continue;
+
+    uint8_t pos = plan.count++;
+    plan.functions[pos] = i;
+    plan.triggers[pos] = pos;
+    for (uint8_t j = 0; j < pos; j++) {
+      const CustomFunctionData * other = &functions[plan.functions[j]];
+      if (CFN_SWITCH(other) == CFN_SWITCH(cfn) &&
+          getFunctionSwitchFlags(other) == getFunctionSwitchFlags(cfn)) {
+        plan.triggers[pos] = plan.triggers[j];
+        break;
+      }
+    }
+  }
+}
+
 void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
 {
   MASK_FUNC_TYPE newActiveFunctions  = 0;
@@ -138,334 +189,354 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
   #define PLAY_INDEX   (i+playFirstIndex)
 
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
-  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
-    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+  if (safetyChSet) {
+    for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+    }
+    safetyChSet = false;
   }
 #endif
 
 #if defined(GVARS)
-  for (uint8_t i=0; i<MAX_TRIMS; i++) {
-    trimGvar[i] = -1;
+  if (trimGvarSet) {
+    for (uint8_t i=0; i<MAX_TRIMS; i++) {
+      trimGvar[i] = -1;
+    }
+    trimGvarSet = false;
   }
 #endif
 
-  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+  CustomFunctionsPlan & plan = functionsContext.plan;
+  if (!isFunctionsPlanValid(functions, plan)) {
+    buildFunctionsPlan(functions, plan);
+  }
+
+  // state of each trigger in this pass: 0 = not read yet, 1 = off, 2 = on
+  uint8_t triggerStates[MAX_SPECIAL_FUNCTIONS];
+  memclear(triggerStates, plan.count);
+
+  for (uint8_t pos=0; pos<plan.count; pos++) {
+    uint8_t i = plan.functions[pos];
     const CustomFunctionData * cfn = &functions[i];
-    swsrc_t swtch = CFN_SWITCH(cfn);
-    if (swtch) {
-      MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
+    MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
 
-      bool active = getSwitch(
-          swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+    uint8_t & trigger = triggerStates[plan.triggers[pos]];
+    if (!trigger) {
+      trigger = getSwitch(CFN_SWITCH(cfn), getFunctionSwitchFlags(cfn)) ? 2 : 1;
+    }
+    bool active = (trigger == 2);
 
-      if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
-        active &= (bool)CFN_ACTIVE(cfn);
-      }
+    if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
+      active &= (bool)CFN_ACTIVE(cfn);
+    }
 
-      if (active) {
-        switch (CFN_FUNC(cfn)) {
+    if (active) {
+      switch (CFN_FUNC(cfn)) {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
-          case FUNC_OVERRIDE_CHANNEL:
-            safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
-            break;
+        case FUNC_OVERRIDE_CHANNEL:
+          safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
+          safetyChSet = true;
+          break;
 #endif
 
-          case FUNC_TRAINER: {
-            uint8_t param = CFN_CH_INDEX(cfn);
-            if (param == 0)
-              newActiveFunctions |= 0x0F;
-            else if (param <= MAX_STICKS)
-              newActiveFunctions |= (1 << (param - 1));
-            else if (param == MAX_STICKS + 1)
-              newActiveFunctions |= (1u << FUNCTION_TRAINER_CHANNELS);
-            break;
-          }
-
-          case FUNC_INSTANT_TRIM:
-            newActiveFunctions |= (1u << FUNCTION_INSTANT_TRIM);
-            if (!isFunctionActive(FUNCTION_INSTANT_TRIM)) {
-              if (IS_INSTANT_TRIM_ALLOWED()) {
-                instantTrim();
-              }
-            }
-            break;
+        case FUNC_TRAINER: {
+          uint8_t param = CFN_CH_INDEX(cfn);
+          if (param == 0)
+            newActiveFunctions |= 0x0F;
+          else if (param <= MAX_STICKS)
+            newActiveFunctions |= (1 << (param - 1));
+          else if (param == MAX_STICKS + 1)
+            newActiveFunctions |= (1u << FUNCTION_TRAINER_CHANNELS);
+          break;
+        }
 
-          case FUNC_RESET:
-            switch (CFN_PARAM(cfn)) {
-              case FUNC_RESET_TIMER1:
-              case FUNC_RESET_TIMER2:
-              case FUNC_RESET_TIMER3:
-                timerReset(CFN_PARAM(cfn));
-                break;
-              case FUNC_RESET_FLIGHT:
-                if (!(functionsContext.activeSwitches & switch_mask)) {
-                  mainRequestFlags |=
-                      (1 << REQUEST_FLIGHT_RESET);  // on systems with threads
-                                                    // flightReset() must not be
-                                                    // called from the mixers
-                                                    // thread!
-                }
-                break;
-              case FUNC_RESET_TELEMETRY:
-                telemetryReset();
-                break;
+        case FUNC_INSTANT_TRIM:
+          newActiveFunctions |= (1u << FUNCTION_INSTANT_TRIM);
+          if (!isFunctionActive(FUNCTION_INSTANT_TRIM)) {
+            if (IS_INSTANT_TRIM_ALLOWED()) {
+              instantTrim();
             }
-            if (CFN_PARAM(cfn) >= FUNC_RESET_PARAM_FIRST_TELEM) {
-              uint8_t item = CFN_PARAM(cfn) - FUNC_RESET_PARAM_FIRST_TELEM;
-              if (item < MAX_TELEMETRY_SENSORS) {
-                telemetryItems[item].clear();
+          }
+          break;
+
+        case FUNC_RESET:
+          switch (CFN_PARAM(cfn)) {
+            case FUNC_RESET_TIMER1:
+            case FUNC_RESET_TIMER2:
+            case FUNC_RESET_TIMER3:
+              timerReset(CFN_PARAM(cfn));
+              break;
+            case FUNC_RESET_FLIGHT:
+              if (!(functionsContext.activeSwitches & switch_mask)) {
+                mainRequestFlags |=
+                    (1 << REQUEST_FLIGHT_RESET);  // on systems with threads
+                                                  // flightReset() must not be
+                                                  // called from the mixers
+                                                  // thread!
               }
+              break;
+            case FUNC_RESET_TELEMETRY:
+              telemetryReset();
+              break;
+          }
+          if (CFN_PARAM(cfn) >= FUNC_RESET_PARAM_FIRST_TELEM) {
+            uint8_t item = CFN_PARAM(cfn) - FUNC_RESET_PARAM_FIRST_TELEM;
+            if (item < MAX_TELEMETRY_SENSORS) {
+              telemetryItems[item].clear();
             }
-            break;
+          }
+          // the telemetry switches may have changed
+          memclear(triggerStates, plan.count);
+          break;
 
-          case FUNC_SET_TIMER:
-            timerSet(CFN_TIMER_INDEX(cfn), CFN_PARAM(cfn));
-            break;
+        case FUNC_SET_TIMER:
+          timerSet(CFN_TIMER_INDEX(cfn), CFN_PARAM(cfn));
+          break;
 
-          case FUNC_SET_FAILSAFE:
-            setCustomFailsafe(CFN_PARAM(cfn));
-            break;
+        case FUNC_SET_FAILSAFE:
+          setCustomFailsafe(CFN_PARAM(cfn));
+          break;
 
 #if defined(DANGEROUS_MODULE_FUNCTIONS)
-          case FUNC_RANGECHECK:
-          case FUNC_BIND: {
-            unsigned int moduleIndex = CFN_PARAM(cfn);
-            if (moduleIndex < NUM_MODULES) {
-              moduleState[moduleIndex].mode =
-                  1 + CFN_FUNC(cfn) - FUNC_RANGECHECK;
-            }
-            break;
+        case FUNC_RANGECHECK:
+        case FUNC_BIND: {
+          unsigned int moduleIndex = CFN_PARAM(cfn);
+          if (moduleIndex < NUM_MODULES) {
+            moduleState[moduleIndex].mode =
+                1 + CFN_FUNC(cfn) - FUNC_RANGECHECK;
           }
+          break;
+        }
 #endif
 
 #if defined(GVARS)
-          case FUNC_ADJUST_GVAR:
-            if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_CONSTANT) {
-              SET_GVAR(CFN_GVAR_INDEX(cfn), CFN_PARAM(cfn),
-                       mixerCurrentFlightMode);
-            } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_GVAR) {
-              SET_GVAR(CFN_GVAR_INDEX(cfn),
-                       GVAR_VALUE(CFN_PARAM(cfn),
-                                  getGVarFlightMode(mixerCurrentFlightMode,
-                                                    CFN_PARAM(cfn))),
-                       mixerCurrentFlightMode);
-            } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC) {
-              if (!(functionsContext.activeSwitches & switch_mask)) {
-                SET_GVAR(CFN_GVAR_INDEX(cfn),
-                         limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
-                                        GVAR_VALUE(CFN_GVAR_INDEX(cfn),
-                                                   getGVarFlightMode(
-                                                       mixerCurrentFlightMode,
-                                                       CFN_GVAR_INDEX(cfn))) +
-                                            CFN_PARAM(cfn),
-                                        MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
-                         mixerCurrentFlightMode);
-              }
-            } else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM &&
-                       CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
-              trimGvar[CFN_PARAM(cfn) - MIXSRC_FIRST_TRIM] =
-                  CFN_GVAR_INDEX(cfn);
-            } else {
+        case FUNC_ADJUST_GVAR:
+          if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_CONSTANT) {
+            SET_GVAR(CFN_GVAR_INDEX(cfn), CFN_PARAM(cfn),
+                     mixerCurrentFlightMode);
+          } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_GVAR) {
+            SET_GVAR(CFN_GVAR_INDEX(cfn),
+                     GVAR_VALUE(CFN_PARAM(cfn),
+                                getGVarFlightMode(mixerCurrentFlightMode,
+                                                  CFN_PARAM(cfn))),
+                     mixerCurrentFlightMode);
+          } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC) {
+            if (!(functionsContext.activeSwitches & switch_mask)) {
               SET_GVAR(CFN_GVAR_INDEX(cfn),
                        limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
-                                      calcRESXto100(getValue(CFN_PARAM(cfn))),
+                                      GVAR_VALUE(CFN_GVAR_INDEX(cfn),
+                                                 getGVarFlightMode(
+                                                     mixerCurrentFlightMode,
+                                                     CFN_GVAR_INDEX(cfn))) +
+                                          CFN_PARAM(cfn),
                                       MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
                        mixerCurrentFlightMode);
             }
-            break;
+          } else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM &&
+                     CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
+            trimGvar[CFN_PARAM(cfn) - MIXSRC_FIRST_TRIM] =
+                CFN_GVAR_INDEX(cfn);
+            trimGvarSet = true;
+          } else {
+            SET_GVAR(CFN_GVAR_INDEX(cfn),
+                     limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
+                                    calcRESXto100(getValue(CFN_PARAM(cfn))),
+                                    MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
+                     mixerCurrentFlightMode);
+          }
+          break;
 #endif
 
-          case FUNC_VOLUME: {
-            getvalue_t raw = getValue(CFN_PARAM(cfn));
-            // only set volume if input changed more than hysteresis
-            if (abs(requiredSpeakerVolumeRawLast - raw) > VOLUME_HYSTERESIS) {
-              requiredSpeakerVolumeRawLast = raw;
-            }
-            requiredSpeakerVolume =
-                ((1024 + requiredSpeakerVolumeRawLast) * VOLUME_LEVEL_MAX) /
-                2048;
-            break;
+        case FUNC_VOLUME: {
+          getvalue_t raw = getValue(CFN_PARAM(cfn));
+          // only set volume if input changed more than hysteresis
+          if (abs(requiredSpeakerVolumeRawLast - raw) > VOLUME_HYSTERESIS) {
+            requiredSpeakerVolumeRawLast = raw;
           }
+          requiredSpeakerVolume =
+              ((1024 + requiredSpeakerVolumeRawLast) * VOLUME_LEVEL_MAX) /
+              2048;
+          break;
+        }
 
 #if defined(SDCARD)
-          case FUNC_PLAY_SOUND:
-          case FUNC_PLAY_TRACK:
-          case FUNC_PLAY_VALUE:
+        case FUNC_PLAY_SOUND:
+        case FUNC_PLAY_TRACK:
+        case FUNC_PLAY_VALUE:
 #if defined(HAPTIC)
-          case FUNC_HAPTIC:
+        case FUNC_HAPTIC:
 #endif
-          {
-            if (isRepeatDelayElapsed(functions, functionsContext, i)) {
-              if (!IS_PLAYING(PLAY_INDEX)) {
-                if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
-                  AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + CFN_PARAM(cfn));
-                } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
-                  PLAY_VALUE(CFN_PARAM(cfn), PLAY_INDEX);
-                }
+        {
+          if (isRepeatDelayElapsed(functions, functionsContext, i)) {
+            if (!IS_PLAYING(PLAY_INDEX)) {
+              if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
+                AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + CFN_PARAM(cfn));
+              } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
+                PLAY_VALUE(CFN_PARAM(cfn), PLAY_INDEX);
+              }
 #if defined(HAPTIC)
-                else if (CFN_FUNC(cfn) == FUNC_HAPTIC) {
-                  haptic.event(AU_SPECIAL_SOUND_LAST + CFN_PARAM(cfn));
-                }
+              else if (CFN_FUNC(cfn) == FUNC_HAPTIC) {
+                haptic.event(AU_SPECIAL_SOUND_LAST + CFN_PARAM(cfn));
+              }
 #endif
-                else {
-                  playCustomFunctionFile(cfn, PLAY_INDEX);
-                }
+              else {
+                playCustomFunctionFile(cfn, PLAY_INDEX);
               }
             }
-            break;
           }
+          break;
+        }
 
-          case FUNC_BACKGND_MUSIC:
-            if (!(newActiveFunctions & (1 << FUNCTION_BACKGND_MUSIC))) {
-              newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC);
-              if (!IS_PLAYING(PLAY_INDEX)) {
-                playCustomFunctionFile(cfn, PLAY_INDEX);
-              }
+        case FUNC_BACKGND_MUSIC:
+          if (!(newActiveFunctions & (1 << FUNCTION_BACKGND_MUSIC))) {
+            newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC);
+            if (!IS_PLAYING(PLAY_INDEX)) {
+              playCustomFunctionFile(cfn, PLAY_INDEX);
             }
-            break;
+          }
+          break;
 
-          case FUNC_BACKGND_MUSIC_PAUSE:
-            newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC_PAUSE);
-            break;
+        case FUNC_BACKGND_MUSIC_PAUSE:
+          newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC_PAUSE);
+          break;
 
 #else
-          case FUNC_PLAY_SOUND:
-          case FUNC_PLAY_TRACK:
-          case FUNC_PLAY_BOTH:
-          case FUNC_PLAY_VALUE: {
-            tmr10ms_t tmr10ms = get_tmr10ms();
-            uint8_t repeatParam = CFN_PLAY_REPEAT(cfn);
-            if (!functionsContext.lastFunctionTime[i] ||
-                (CFN_FUNC(cfn) == FUNC_PLAY_BOTH &&
-                 active !=
-                     (bool)(functionsContext.activeSwitches & switch_mask)) ||
-                (repeatParam &&
-                 (signed)(tmr10ms - functionsContext.lastFunctionTime[i]) >=
-                     1000 * repeatParam)) {
-              functionsContext.lastFunctionTime[i] = tmr10ms;
-              uint8_t param = CFN_PARAM(cfn);
-              if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
-                AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + param);
-              } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
-                PLAY_VALUE(param, PLAY_INDEX);
-              } else {
+        case FUNC_PLAY_SOUND:
+        case FUNC_PLAY_TRACK:
+        case FUNC_PLAY_BOTH:
+        case FUNC_PLAY_VALUE: {
+          tmr10ms_t tmr10ms = get_tmr10ms();
+          uint8_t repeatParam = CFN_PLAY_REPEAT(cfn);
+          if (!functionsContext.lastFunctionTime[i] ||
+              (CFN_FUNC(cfn) == FUNC_PLAY_BOTH &&
+               active !=
+                   (bool)(functionsContext.activeSwitches & switch_mask)) ||
+              (repeatParam &&
+               (signed)(tmr10ms - functionsContext.lastFunctionTime[i]) >=
+                   1000 * repeatParam)) {
+            functionsContext.lastFunctionTime[i] = tmr10ms;
+            uint8_t param = CFN_PARAM(cfn);
+            if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
+              AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + param);
+            } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
+              PLAY_VALUE(param, PLAY_INDEX);
+            } else {
 #if defined(GVARS)
-                if (CFN_FUNC(cfn) == FUNC_PLAY_TRACK && param > 250)
-                  param = GVAR_VALUE(
-                      param - 251,
-                      getGVarFlightMode(mixerCurrentFlightMode, param - 251));
+              if (CFN_FUNC(cfn) == FUNC_PLAY_TRACK && param > 250)
+                param = GVAR_VALUE(
+                    param - 251,
+                    getGVarFlightMode(mixerCurrentFlightMode, param - 251));
 #endif
-                PUSH_CUSTOM_PROMPT(active ? param : param + 1, PLAY_INDEX);
-              }
-            }
-            if (!active) {
-              // PLAY_BOTH would change activeFnSwitches otherwise
-              switch_mask = 0;
+              PUSH_CUSTOM_PROMPT(active ? param : param + 1, PLAY_INDEX);
             }
-            break;
           }
+          if (!active) {
+            // PLAY_BOTH would change activeFnSwitches otherwise
+            switch_mask = 0;
+          }
+          break;
+        }
 #endif
 
 #if defined(VARIO)
-          case FUNC_VARIO:
-            newActiveFunctions |= (1u << FUNCTION_VARIO);
-            break;
+        case FUNC_VARIO:
+          newActiveFunctions |= (1u << FUNCTION_VARIO);
+          break;
 #endif
 
 #if defined(SDCARD)
-          case FUNC_LOGS:
-            if (CFN_PARAM(cfn)) {
-              newActiveFunctions |= (1u << FUNCTION_LOGS);
-              logDelay100ms = CFN_PARAM(
-                  cfn);  // logging period is 0..25.5s in 100ms increments
-            }
-            break;
+        case FUNC_LOGS:
+          if (CFN_PARAM(cfn)) {
+            newActiveFunctions |= (1u << FUNCTION_LOGS);
+            logDelay100ms = CFN_PARAM(
+                cfn);  // logging period is 0..25.5s in 100ms increments
+          }
+          break;
 #endif
 
-          case FUNC_BACKLIGHT: {
-            newActiveFunctions |= (1u << FUNCTION_BACKLIGHT);
-            if (!CFN_PARAM(cfn)) {  // When no source is set, backlight works
-                                    // like original backlight and turn on
-                                    // regardless of backlight settings
-              requiredBacklightBright = BACKLIGHT_FORCED_ON;
-              break;
-            }
+        case FUNC_BACKLIGHT: {
+          newActiveFunctions |= (1u << FUNCTION_BACKLIGHT);
+          if (!CFN_PARAM(cfn)) {  // When no source is set, backlight works
+                                  // like original backlight and turn on
+                                  // regardless of backlight settings
+            requiredBacklightBright = BACKLIGHT_FORCED_ON;
+            break;
+          }
 
-            getvalue_t raw = getValue(CFN_PARAM(cfn));
+          getvalue_t raw = getValue(CFN_PARAM(cfn));
 #if defined(COLORLCD)
-            if (raw == -1024)
-              requiredBacklightBright = 100;
-            else
-              requiredBacklightBright =
-                  (1024 - raw) * (BACKLIGHT_LEVEL_MAX - BACKLIGHT_LEVEL_MIN) /
-                  2048;
+          if (raw == -1024)
+            requiredBacklightBright = 100;
+          else
+            requiredBacklightBright =
+                (1024 - raw) * (BACKLIGHT_LEVEL_MAX - BACKLIGHT_LEVEL_MIN) /
+                2048;
 #elif defined(OLED_SCREEN)
-            requiredBacklightBright = (raw + 1024) * 254 / 2048;
+          requiredBacklightBright = (raw + 1024) * 254 / 2048;
 #else
-            requiredBacklightBright = (1024 - raw) * 100 / 2048;
+          requiredBacklightBright = (1024 - raw) * 100 / 2048;
 #endif
-            break;
-          }
+          break;
+        }
 
-          case FUNC_SCREENSHOT:
-            if (!(functionsContext.activeSwitches & switch_mask)) {
-              mainRequestFlags |= (1u << REQUEST_SCREENSHOT);
-            }
-            break;
+        case FUNC_SCREENSHOT:
+          if (!(functionsContext.activeSwitches & switch_mask)) {
+            mainRequestFlags |= (1u << REQUEST_SCREENSHOT);
+          }
+          break;
 
 #if defined(PXX2)
-          case FUNC_RACING_MODE:
-            if (isRacingModeEnabled()) {
-              newActiveFunctions |= (1u << FUNCTION_RACING_MODE);
-            }
-            break;
+        case FUNC_RACING_MODE:
+          if (isRacingModeEnabled()) {
+            newActiveFunctions |= (1u << FUNCTION_RACING_MODE);
+          }
+          break;
 #endif
 #if defined(HARDWARE_TOUCH)
-          case FUNC_DISABLE_TOUCH:
-            newActiveFunctions |= (1u << FUNCTION_DISABLE_TOUCH);
-            break;
+        case FUNC_DISABLE_TOUCH:
+          newActiveFunctions |= (1u << FUNCTION_DISABLE_TOUCH);
+          break;
 #endif
 #if defined(AUDIO_MUTE_GPIO)
-          case FUNC_DISABLE_AUDIO_AMP:
-            newActiveFunctions |= (1u << FUNCTION_DISABLE_AUDIO_AMP);
-            break;
+        case FUNC_DISABLE_AUDIO_AMP:
+          newActiveFunctions |= (1u << FUNCTION_DISABLE_AUDIO_AMP);
+          break;
 #endif
 #if defined(COLORLCD)
-          case FUNC_SET_SCREEN:
-            if (isRepeatDelayElapsed(functions, functionsContext, i)) {
-              TRACE("SET VIEW %d", (CFN_PARAM(cfn)));
-              int8_t screenNumber = max(0, CFN_PARAM(cfn) - 1);
-              setRequestedMainView(screenNumber);
-              mainRequestFlags |= (1u << REQUEST_MAIN_VIEW);
-            }
-            break;
+        case FUNC_SET_SCREEN:
+          if (isRepeatDelayElapsed(functions, functionsContext, i)) {
+            TRACE("SET VIEW %d", (CFN_PARAM(cfn)));
+            int8_t screenNumber = max(0, CFN_PARAM(cfn) - 1);
+            setRequestedMainView(screenNumber);
+            mainRequestFlags |= (1u << REQUEST_MAIN_VIEW);
+          }
+          break;
 #endif
 #if defined(DEBUG)
-          case FUNC_TEST:
-            testFunc();
-            break;
+        case FUNC_TEST:
+          testFunc();
+          break;
 #endif
-        }
+      }
 
-        newActiveSwitches |= switch_mask;
-      } else {
-        functionsContext.lastFunctionTime[i] = 0;
+      newActiveSwitches |= switch_mask;
+    } else {
+      functionsContext.lastFunctionTime[i] = 0;
 #if defined(DANGEROUS_MODULE_FUNCTIONS)
-        if (functionsContext.activeSwitches & switch_mask) {
-          switch (CFN_FUNC(cfn)) {
-            case FUNC_RANGECHECK:
-            case FUNC_BIND:
-            {
-              unsigned int moduleIndex = CFN_PARAM(cfn);
-              if (moduleIndex < NUM_MODULES) {
-                moduleState[moduleIndex].mode = 0;
-              }
-              break;
+      if (functionsContext.activeSwitches & switch_mask) {
+        switch (CFN_FUNC(cfn)) {
+          case FUNC_RANGECHECK:
+          case FUNC_BIND:
+          {
+            unsigned int moduleIndex = CFN_PARAM(cfn);
+            if (moduleIndex < NUM_MODULES) {
+              moduleState[moduleIndex].mode = 0;
             }
+            break;
           }
         }
-#endif
       }
+#endif
     }
   }
 
@@ -22,6 +22,7 @@
 #include "opentx.h"
 #include "tasks.h"
 #include "mixer_scheduler.h"
+#include "mixer_stats.h"
 
 #include "hal/adc_driver.h"
 
@@ -240,6 +241,10 @@ void menuStatisticsDebug2(event_t event)
     //   telemetryErrors  = 0;
     //   break;
 
+    case EVT_KEY_FIRST(KEY_ENTER):
+      mixerStatsReset();
+      break;
+
     case EVT_KEY_FIRST(KEY_UP):
 #if defined(KEYS_GPIO_REG_PAGEDN)
     case EVT_KEY_BREAK(KEY_PAGEDN):
@@ -268,6 +273,22 @@ void menuStatisticsDebug2(event_t event)
 
   // lcdDrawTextAlignedLeft(y, "Tlm RX Err");
   // lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, telemetryErrors, RIGHT);
+
+  lcdDrawTextAlignedLeft(y, STR_TMIX99);
+  lcdDrawText(MENU_DEBUG_COL1_OFS, y, "<");
+  lcdDrawNumber(lcdLastRightPos, y, mixerStatsPercentile(mixerStats.cycleHistogram, 99) / 10, PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
+  lcdDrawTextAlignedLeft(y, STR_MIXER_JITTER);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerStats.jitterMax / 10, PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
+  lcdDrawTextAlignedLeft(y, STR_MIXER_OVERRUNS);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerStats.overruns, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, mixerStats.cycles, LEFT);
   y += FH;
 
 #if defined(BLUETOOTH)
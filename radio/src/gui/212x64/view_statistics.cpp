@@ -22,6 +22,8 @@
 #include "hal/adc_driver.h"
 #include "opentx.h"
 #include "tasks.h"
+#include "mixer_scheduler.h"
+#include "mixer_stats.h"
 
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
@@ -237,12 +239,51 @@ void menuStatisticsDebug2(event_t event)
     // case EVT_KEY_LONG(KEY_ENTER):
     //   telemetryErrors = 0;
     //   break;
+
+    case EVT_KEY_FIRST(KEY_ENTER):
+      mixerStatsReset();
+      break;
   }
 
   // UART statistics
   // lcdDrawTextAlignedLeft(MENU_DEBUG_ROW1, "Tlm RX Err");
   // lcdDrawNumber(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW1, telemetryErrors, RIGHT);
 
+  // Mixer statistics
+  coord_t y = FH + 1;
+  lcdDrawTextAlignedLeft(y, STR_TMIX99);
+  lcdDrawText(MENU_DEBUG_COL1_OFS, y, "<");
+  lcdDrawNumber(lcdLastRightPos, y, mixerStatsPercentile(mixerStats.cycleHistogram, 99) / 10, PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  lcdDrawText(lcdLastRightPos, y, " (");
+  lcdDrawNumber(lcdLastRightPos, y, getMixerSchedulerPeriod() / 1000, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "ms)");
+  y += FH;
+
+  lcdDrawTextAlignedLeft(y, STR_MIXER_JITTER);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerStats.jitterMax / 10, PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
+  lcdDrawTextAlignedLeft(y, STR_MIXER_OVERRUNS);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerStats.overruns, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, mixerStats.cycles, LEFT);
+  y += FH;
+
+  // stages max duration
+  lcdDrawText(0, y+1, "ADC", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos+1, y, mixerStats.stageMax[MIXER_STAGE_ADC], LEFT);
+  lcdDrawText(lcdLastRightPos+FW, y+1, "SW", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos+1, y, mixerStats.stageMax[MIXER_STAGE_SWITCHES], LEFT);
+  lcdDrawText(lcdLastRightPos+FW, y+1, "MIX", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos+1, y, mixerStats.stageMax[MIXER_STAGE_MIXES], LEFT);
+  lcdDrawText(lcdLastRightPos+FW, y+1, "OUT", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos+1, y, mixerStats.stageMax[MIXER_STAGE_PULSES], LEFT);
+  lcdDrawText(lcdLastRightPos+FW, y+1, "PER", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos+1, y, mixerStats.stageMax[MIXER_STAGE_PERIODIC], LEFT);
+  lcdDrawText(lcdLastRightPos, y, "us");
+
 
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
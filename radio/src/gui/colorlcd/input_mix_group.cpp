@@ -23,6 +23,7 @@
 #include "channel_bar.h"
 
 #include "opentx.h"
+#include "mixes.h"
 
 #include <algorithm>
 
@@ -72,6 +73,8 @@ InputMixGroup::InputMixGroup(Window* parent, mixsrc_t idx) :
     lv_obj_set_style_pad_top(label, -1, 0);
 #endif
   lv_label_set_text(label, getSourceString(idx));
+  // channels in a loop of channels are highlighted
+  lv_obj_set_style_text_color(label, makeLvColor(COLOR_THEME_WARNING), LV_STATE_USER_1);
   lv_obj_set_grid_cell(label,
                        LV_GRID_ALIGN_START, 0, 1,
                        chText?LV_GRID_ALIGN_START:LV_GRID_ALIGN_CENTER, 0, 1);
@@ -109,6 +112,18 @@ void InputMixGroup::disableMixerMonitor()
   monitor = nullptr;
 }
 
+void InputMixGroup::checkEvents()
+{
+  Window::checkEvents();
+
+  if (idx >= MIXSRC_FIRST_CH && idx <= MIXSRC_LAST_CH) {
+    if (isMixChannelInLoop(idx - MIXSRC_FIRST_CH))
+      lv_obj_add_state(label, LV_STATE_USER_1);
+    else
+      lv_obj_clear_state(label, LV_STATE_USER_1);
+  }
+}
+
 void InputMixGroup::addLine(Window* line, const uint8_t* symbol)
 {
   lines.emplace_back(line, symbol);
@@ -56,6 +56,8 @@ class InputMixGroup : public Window
   void disableMixerMonitor();
 
   bool mixerMonitorEnabled() { return monitor != nullptr; }
+
+  void checkEvents() override;
     
   mixsrc_t getMixSrc() { return idx; }
   size_t getLineCount() { return lines.size(); }
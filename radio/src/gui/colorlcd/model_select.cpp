@@ -244,6 +244,8 @@ class ModelButton : public Button
       Button(parent, rect), modelCell(modelCell)
   {
     m_setSelected = std::move(setSelected);
+    pending = modelslist.isPending(modelCell);
+    updateCount = modelslist.getUpdateCount();
 
     lv_obj_clear_flag(lvobj, LV_OBJ_FLAG_CLICK_FOCUSABLE);
     setWidth(MODEL_SELECT_CELL_WIDTH);
@@ -268,7 +270,10 @@ class ModelButton : public Button
     }
     buffer->clear(COLOR_THEME_PRIMARY2);
 
-    if (error) {
+    if (pending) {
+      buffer->drawText(width() / 2, 56, STR_LOADING,
+                       FONT(XXS) | COLOR_THEME_SECONDARY1 | CENTERED);
+    } else if (error) {
       std::string errorMsg = "(";
       errorMsg += STR_INVALID_MODEL;
       errorMsg += ")";
@@ -305,8 +310,13 @@ class ModelButton : public Button
     } else {
       dc->drawFilledRect(0, 0, width(), 20, SOLID, COLOR_THEME_PRIMARY2);
     }
-    dc->drawSizedText(width() / 2, 2, modelCell->modelName, LEN_MODEL_NAME,
-                      COLOR_THEME_SECONDARY1 | CENTERED);
+    if (pending) {
+      dc->drawSizedText(width() / 2, 2, modelCell->modelFilename,
+                        LEN_MODEL_FILENAME, COLOR_THEME_SECONDARY1 | CENTERED);
+    } else {
+      dc->drawSizedText(width() / 2, 2, modelCell->modelName, LEN_MODEL_NAME,
+                        COLOR_THEME_SECONDARY1 | CENTERED);
+    }
 
     if (!hasFocus()) {
       dc->drawSolidRect(0, 0, width(), height(), 1, COLOR_THEME_SECONDARY2);
@@ -316,6 +326,21 @@ class ModelButton : public Button
     }
   }
 
+  void checkEvents() override
+  {
+    Button::checkEvents();
+
+    // the model is drawn again once read in the background
+    if (pending && updateCount != modelslist.getUpdateCount()) {
+      updateCount = modelslist.getUpdateCount();
+      pending = modelslist.isPending(modelCell);
+      if (!pending) {
+        loaded = false;
+        invalidate();
+      }
+    }
+  }
+
   const char *modelFilename() { return modelCell->modelFilename; }
   ModelCell *getModelCell() const { return modelCell; }
 
@@ -327,6 +352,8 @@ class ModelButton : public Button
 
  protected:
   bool loaded = false;
+  bool pending = false;
+  uint32_t updateCount = 0;
   ModelCell *modelCell;
   BitmapBuffer *buffer = nullptr;
   std::function<void()> m_setSelected = nullptr;
@@ -523,9 +550,21 @@ void ModelsPageBody::openMenu()
   }
 }
 
+void ModelsPageBody::checkEvents()
+{
+  FormWindow::checkEvents();
+
+  // names and labels of all the models are known: sort and filter again
+  if (updating && !modelslist.isUpdating()) {
+    update();
+    if (refreshLabels != nullptr) refreshLabels();
+  }
+}
+
 void ModelsPageBody::update()
 {
   clear();
+  updating = modelslist.isUpdating();
 
   ModelsVector models;
   if (selectedLabels.size()) {
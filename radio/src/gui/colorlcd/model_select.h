@@ -38,6 +38,7 @@ class ModelsPageBody : public FormWindow
   ModelsPageBody(Window *parent, const rect_t &rect);
 
   void update();
+  void checkEvents() override;
 
   void setLabels(LabelsVector labels)
   {
@@ -60,6 +61,7 @@ class ModelsPageBody : public FormWindow
   ModelsSortBy _sortOrder;
   bool isDirty = false;
   bool refresh = false;
+  bool updating = false;
   std::string selectedLabel;
   LabelsVector selectedLabels;
   ModelCell *focusedModel = nullptr;
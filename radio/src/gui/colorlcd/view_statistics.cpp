@@ -26,6 +26,7 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "mixer_stats.h"
 
 static const lv_coord_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_FR(1),
                                      LV_GRID_FR(1), LV_GRID_FR(1),
@@ -261,6 +262,31 @@ void DebugViewPage::build(FormWindow* window)
   line = form->newLine(&grid);
   line->padAll(2);
 
+  new StaticText(line, rect_t{}, STR_TMIX99, 0, COLOR_THEME_PRIMARY1);
+  new DynamicNumber<uint32_t>(
+      line, rect_t{},
+      [] { return mixerStatsPercentile(mixerStats.cycleHistogram, 99) / 10; },
+      PREC2 | COLOR_THEME_PRIMARY1, "< ", pad_STR_MS.c_str());
+
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  new StaticText(line, rect_t{}, STR_MIXER_JITTER, 0, COLOR_THEME_PRIMARY1);
+  new DynamicNumber<uint16_t>(
+      line, rect_t{}, [] { return mixerStats.jitterMax / 10; },
+      PREC2 | COLOR_THEME_PRIMARY1, nullptr, pad_STR_MS.c_str());
+
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  new StaticText(line, rect_t{}, STR_MIXER_OVERRUNS, 0, COLOR_THEME_PRIMARY1);
+  new DynamicNumber<uint32_t>(
+      line, rect_t{}, [] { return mixerStats.overruns; },
+      COLOR_THEME_PRIMARY1);
+
+  line = form->newLine(&grid);
+  line->padAll(2);
+
   // Free mem
   static std::string pad_STR_BYTES = " " + std::string(STR_BYTES);
   new StaticText(line, rect_t{}, STR_FREE_MEM_LABEL, 0, COLOR_THEME_PRIMARY1);
@@ -387,6 +413,7 @@ void DebugViewPage::build(FormWindow* window)
   auto btn = new TextButton(line, rect_t{0, 0, 0, 24}, STR_MENUTORESET,
                             [=]() -> uint8_t {
                               maxMixerDuration = 0;
+                              mixerStatsReset();
 #if defined(LUA)
                               maxLuaInterval = 0;
                               maxLuaDuration = 0;
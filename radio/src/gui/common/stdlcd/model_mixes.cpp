@@ -323,7 +323,7 @@ void menuModelMixAll(event_t event)
     MixData * md = mixAddress(i);
     if (i < getMixCount() && (md->destCh + 1 == ch)) {
       if (cur-menuVerticalOffset >= 0 && cur-menuVerticalOffset < NUM_BODY_LINES) {
-        putsChn(0, y, ch, 0); // show CHx
+        putsChn(0, y, ch, isMixChannelInLoop(ch - 1) ? BLINK : 0); // show CHx
       }
       uint8_t mixCnt = 0;
       do {
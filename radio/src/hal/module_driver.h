@@ -56,6 +56,11 @@ struct etx_proto_driver_t {
     // Process input data byte (telemetry)
     void (*processData)(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len);
 
+    // Process a block of input data (telemetry), optional:
+    // processData() is called for each byte otherwise
+    void (*processBlock)(void* ctx, const uint8_t* data, uint32_t data_len,
+                         uint8_t* buffer, uint8_t* len);
+
     // Some module settings may have been modified
     void (*onConfigChange)(void* ctx);
 
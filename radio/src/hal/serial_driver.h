@@ -90,6 +90,13 @@ typedef struct {
 
   // Fetch a byte by its index from the end of the buffer
   int (*getLastByte)(void* ctx, uint32_t idx, uint8_t* data);
+
+  // Get the contiguous bytes available in the internal buffer without
+  // consuming them (optional, returns the number of bytes)
+  uint32_t (*peekRxBuffer)(void* ctx, const uint8_t** data);
+
+  // Consume bytes returned by peekRxBuffer()
+  void (*consumeRxBuffer)(void* ctx, uint32_t len);
   
   // Clear internal buffer
   void (*clearRxBuffer)(void* ctx);
@@ -41,7 +41,7 @@
     .status = _STORAGE_DRIVER.status,
     .read = disk_cache_read,
     .write = disk_cache_write,
-    .ioctl = _STORAGE_DRIVER.ioctl,
+    .ioctl = disk_cache_ioctl,
   };
 #endif
 
@@ -69,6 +69,13 @@ void storagePreMountHook()
 #endif
 }
 
+void storagePreUnmountHook()
+{
+#if defined(DISK_CACHE)
+  diskCache.flush();
+#endif
+}
+
 bool storageIsPresent()
 {
   return (_STORAGE_DRIVER.status(0) & STA_NODISK) == 0;
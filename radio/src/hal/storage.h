@@ -30,6 +30,9 @@ void storageInit();
 // Called before the storage is mounted
 void storagePreMountHook();
 
+// Called before the storage is unmounted
+void storagePreUnmountHook();
+
 bool storageIsPresent();
 
 #define SD_CARD_PRESENT() storageIsPresent()
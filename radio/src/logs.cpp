@@ -19,13 +19,20 @@
  * GNU General Public License for more details.
  */
 
+#include <stdarg.h>
+#include <stdio.h>
+
 #include "opentx.h"
 #include "ff.h"
+#include "fifo.h"
+#include "logs.h"
 
 #include "analogs.h"
 #include "switches.h"
 #include "hal/adc_driver.h"
 #include "hal/switch_driver.h"
+#include "tasks/mixer_task.h"
+#include "timers_driver.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -35,12 +42,24 @@ FIL g_oLogFile __DMA;
 uint8_t logDelay100ms;
 static tmr10ms_t lastLogTime = 0;
 
+// Rows are built by logsWrite() in the logging timer context and queued
+// in RAM; logsFlush() writes them to the card in whole sectors from the
+// main loop, so the timer never waits for FatFs.
+#define LOGS_SECTOR_SIZE   512
+#define LOGS_BUFFER_SIZE   4096
+#define LOGS_ROW_SIZE      (MAX_TELEMETRY_SENSORS * 24 + 512)
+
+static Fifo<uint8_t, LOGS_BUFFER_SIZE> logsBuffer;
+static uint8_t logsRow[LOGS_ROW_SIZE];
+static uint8_t logsSector[LOGS_SECTOR_SIZE] __DMA;
+static volatile bool logsActive = false;
+static const char * logsError = nullptr;
+uint32_t logsDroppedRows = 0;
+
 #if !defined(SIMU)
 #include <FreeRTOS/include/FreeRTOS.h>
 #include <FreeRTOS/include/timers.h>
 
-#include "tasks/mixer_task.h"
-
 static TimerHandle_t loggingTimer = nullptr;
 static StaticTimer_t loggingTimerBuffer;
 
@@ -100,25 +119,25 @@ void initLoggingTimer() {                                       // called cyclic
 }
 #endif
 
-void writeHeader();
-
 int getSwitchState(uint8_t swtch) {
   int value = getValue(MIXSRC_FIRST_SWITCH + swtch);
   return (value == 0) ? 0 : (value < 0) ? -1 : +1;
 }
 
+static void writeHeader();
+
 void logsInit()
 {
   memset(&g_oLogFile, 0, sizeof(g_oLogFile));
 }
 
-const char * logsOpen()
+static const char * logsOpenFile(FIL * file, const char * ext)
 {
   // Determine and set log file filename
   FRESULT result;
 
-  // /LOGS/modelnamexxxxxx_YYYY-MM-DD-HHMMSS.log
-  char filename[sizeof(LOGS_PATH) + LEN_MODEL_NAME + 18 + 4 + 1];
+  // /LOGS/modelnamexxxxxx_YYYY-MM-DD-HHMMSS-hr.bin
+  char filename[sizeof(LOGS_PATH) + LEN_MODEL_NAME + 18 + 8 + 1];
 
   if (!sdMounted())
     return STR_NO_SDCARD;
@@ -165,33 +184,211 @@ const char * logsOpen()
   tmp = strAppendDate(tmp, true);
 #endif
 
-  strcpy(tmp, STR_LOGS_EXT);
+  strcpy(tmp, ext);
 
-  result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
+  result = f_open(file, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&g_oLogFile) == 0) {
-    writeHeader();
+  return nullptr;
+}
+
+const char * logsOpen()
+{
+#if defined(LOGS_BINARY)
+  const char * error = logsOpenFile(&g_oLogFile, LOGS_BINARY_EXT);
+#else
+  const char * error = logsOpenFile(&g_oLogFile, STR_LOGS_EXT);
+#endif
+
+  if (!error) {
+    logsDroppedRows = 0;
+    if (f_size(&g_oLogFile) == 0) {
+      writeHeader();
+    }
   }
 
-  return nullptr;
+  return error;
+}
+
+template <class T>
+static void logsDropRows(T & buffer)
+{
+  uint8_t byte;
+  while (buffer.pop(byte));
+}
+
+// writes the queued rows, only whole sectors unless 'all' is set
+template <class T>
+static bool logsWriteBuffer(T & buffer, FIL * file, bool all)
+{
+  while (true) {
+    uint32_t pending = buffer.size();
+    uint32_t chunk = LOGS_SECTOR_SIZE - f_tell(file) % LOGS_SECTOR_SIZE;
+    if (pending < chunk) {
+      if (!all || pending == 0)
+        return true;
+      chunk = pending;
+    }
+
+    for (uint32_t i = 0; i < chunk; i++) {
+      buffer.pop(logsSector[i]);
+    }
+
+    UINT written;
+    if (f_write(file, logsSector, chunk, &written) != FR_OK ||
+        written != chunk) {
+      return false;
+    }
+  }
 }
 
 void logsClose()
 {
   if (g_oLogFile.obj.fs && sdMounted()) {
+    logsWriteBuffer(logsBuffer, &g_oLogFile, true);
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
     }
     lastLogTime = 0;
   }
+  logsDropRows(logsBuffer);
+}
+
+static char * getSensorLogLabel(char * label, const TelemetrySensor & sensor)
+{
+  memset(label, 0, TELEM_LABEL_LEN + 7);
+  strncpy(label, sensor.label, TELEM_LABEL_LEN);
+  uint8_t unit = sensor.unit;
+  if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
+  if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
+    strcat(label, "(");
+    strncat(label, STR_VTELEMUNIT[unit], 3);
+    strcat(label, ")");
+  }
+  return label;
+}
+
+static uint16_t logsColumns;
+static uint16_t logsRowSize;
+static FIL * logsHeaderFile;  // nullptr while only counting the columns
+
+static void writeColumn(uint8_t type, uint8_t prec, const char * name)
+{
+  if (logsHeaderFile) {
+    uint8_t desc[2] = {type, prec};
+    UINT written;
+    f_write(logsHeaderFile, desc, sizeof(desc), &written);
+    f_write(logsHeaderFile, name, strlen(name) + 1, &written);
+  }
+  logsColumns++;
+  logsRowSize += logsColumnSize(type);
+}
+
+static void writeBinaryHeader(FIL * file, uint8_t flags, void (*writeColumns)())
+{
+  // first pass to get the column count and the row size
+  logsHeaderFile = nullptr;
+  logsColumns = 0;
+  logsRowSize = 0;
+  writeColumns();
+
+  uint8_t header[LOGS_BINARY_HEADER_SIZE] = {0};
+  memcpy(header, LOGS_BINARY_MAGIC, 4);
+  header[4] = LOGS_BINARY_VERSION;
+  header[5] = flags;
+  header[6] = logsColumns;
+  header[7] = logsColumns >> 8;
+  header[8] = logsRowSize;
+  header[9] = logsRowSize >> 8;
+
+  UINT written;
+  f_write(file, header, sizeof(header), &written);
+
+  logsHeaderFile = file;
+  writeColumns();
+  logsHeaderFile = nullptr;
+}
+
+static uint8_t * putValue(uint8_t * p, uint32_t value, uint8_t size)
+{
+  for (uint8_t i = 0; i < size; i++) {
+    *p++ = value;
+    value >>= 8;
+  }
+  return p;
+}
+
+#if defined(LOGS_BINARY)
+static uint8_t getSensorColumnType(const TelemetrySensor & sensor)
+{
+  if (sensor.unit == UNIT_GPS)
+    return LOGS_COLUMN_GPS;
+  else if (sensor.unit == UNIT_DATETIME)
+    return LOGS_COLUMN_DATETIME;
+  else if (sensor.unit == UNIT_TEXT)
+    return LOGS_COLUMN_TEXT;
+  else
+    return LOGS_COLUMN_INT32;
+}
+
+// same order as logsFormatRow()
+static void writeColumns()
+{
+  writeColumn(LOGS_COLUMN_TIME, 0, "Time");
+
+  char label[TELEM_LABEL_LEN+7];
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    if (isTelemetryFieldAvailable(i)) {
+      TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      if (sensor.logs) {
+        writeColumn(getSensorColumnType(sensor), sensor.prec,
+                    getSensorLogLabel(label, sensor));
+      }
+    }
+  }
+
+  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    writeColumn(LOGS_COLUMN_INT16, 0, analogGetCanonicalName(ADC_INPUT_MAIN, i));
+  }
+
+  n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    if (!IS_POT_AVAILABLE(i)) continue;
+    writeColumn(LOGS_COLUMN_INT16, 0, analogGetCanonicalName(ADC_INPUT_POT, i));
+  }
 
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    if (SWITCH_EXISTS(i)) {
+      char s[LEN_SWITCH_NAME + 2];
+      *getSwitchName(s, i) = '\0';
+      writeColumn(LOGS_COLUMN_INT8, 0, s);
+    }
+  }
+  writeColumn(LOGS_COLUMN_BITS64, 0, "LSW");
+
+  for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
+    char s[] = "CHxx(us)";
+    strcpy(strAppendUnsigned(&s[2], channel + 1), "(us)");
+    writeColumn(LOGS_COLUMN_INT16, 0, s);
+  }
+
+  writeColumn(LOGS_COLUMN_INT16, 1, "TxBat(V)");
 }
 
-void writeHeader()
+static void writeHeader()
+{
+#if defined(RTCLOCK)
+  writeBinaryHeader(&g_oLogFile, LOGS_BINARY_FLAG_RTC, writeColumns);
+#else
+  writeBinaryHeader(&g_oLogFile, 0, writeColumns);
+#endif
+}
+#else
+static void writeHeader()
 {
 #if defined(RTCLOCK)
   f_puts("Date,Time,", &g_oLogFile);
@@ -199,22 +396,12 @@ void writeHeader()
   f_puts("Time,", &g_oLogFile);
 #endif
 
-
   char label[TELEM_LABEL_LEN+7];
   for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
     if (isTelemetryFieldAvailable(i)) {
       TelemetrySensor & sensor = g_model.telemetrySensors[i];
       if (sensor.logs) {
-        memset(label, 0, sizeof(label));
-        strncpy(label, sensor.label, TELEM_LABEL_LEN);
-        uint8_t unit = sensor.unit;
-        if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
-        if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
-          strcat(label, "(");
-          strncat(label, STR_VTELEMUNIT[unit], 3);
-          strcat(label, ")");
-        }
-        strcat(label, ",");
+        strcat(getSensorLogLabel(label, sensor), ",");
         f_puts(label, &g_oLogFile);
       }
     }
@@ -253,6 +440,7 @@ void writeHeader()
 
   f_puts("TxBat(V)\n", &g_oLogFile);
 }
+#endif
 
 uint32_t getLogicalSwitchesStates(uint8_t first)
 {
@@ -263,146 +451,440 @@ uint32_t getLogicalSwitchesStates(uint8_t first)
   return result;
 }
 
-void logsWrite()
+#if defined(LOGS_BINARY)
+static uint32_t logsFormatRow(tmr10ms_t tmr10ms)
 {
-  static const char * error_displayed = nullptr;
+  uint8_t * p = logsRow;
+
+#if defined(RTCLOCK)
+  p = putValue(p, g_rtcTime, 4);
+  p = putValue(p, g_ms100 * 100, 2);
+#else
+  p = putValue(p, tmr10ms / 100, 4);
+  p = putValue(p, (tmr10ms % 100) * 10, 2);
+#endif
+
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    if (isTelemetryFieldAvailable(i)) {
+      TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      TelemetryItem & telemetryItem = telemetryItems[i];
+      if (sensor.logs) {
+        if (sensor.unit == UNIT_GPS) {
+          p = putValue(p, telemetryItem.gps.latitude, 4);
+          p = putValue(p, telemetryItem.gps.longitude, 4);
+        }
+        else if (sensor.unit == UNIT_DATETIME) {
+          p = putValue(p, telemetryItem.datetime.year, 2);
+          *p++ = telemetryItem.datetime.month;
+          *p++ = telemetryItem.datetime.day;
+          *p++ = telemetryItem.datetime.hour;
+          *p++ = telemetryItem.datetime.min;
+          *p++ = telemetryItem.datetime.sec;
+        }
+        else if (sensor.unit == UNIT_TEXT) {
+          strncpy((char *)p, telemetryItem.text, LOGS_BINARY_TEXT_LEN);
+          p += LOGS_BINARY_TEXT_LEN;
+        }
+        else {
+          p = putValue(p, telemetryItem.value, 4);
+        }
+      }
+    }
+  }
 
+  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
+  auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
+
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    p = putValue(p, calibratedAnalogs[inputMappingConvertMode(offset + i)], 2);
+  }
+
+  n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
+  offset = adcGetInputOffset(ADC_INPUT_POT);
+
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    if (IS_POT_AVAILABLE(i))
+      p = putValue(p, calibratedAnalogs[offset + i], 2);
+  }
+
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    if (SWITCH_EXISTS(i)) {
+      *p++ = getSwitchState(i);
+    }
+  }
+  p = putValue(p, getLogicalSwitchesStates(0), 4);
+  p = putValue(p, getLogicalSwitchesStates(32), 4);
+
+  for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
+    p = putValue(p, PPM_CENTER+channelOutputs[channel]/2, 2); // in us
+  }
+
+  p = putValue(p, g_vbat100mV, 2);
+
+  return p - logsRow;
+}
+#else
+static char * logsRowEnd;
+
+static void logsPrintf(const char * format, ...)
+{
+  char * end = (char *)logsRow + LOGS_ROW_SIZE;
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(logsRowEnd, end - logsRowEnd, format, args);
+  va_end(args);
+  if (len > 0) {
+    logsRowEnd = min(logsRowEnd + len, end - 1);
+  }
+}
+
+static uint32_t logsFormatRow(tmr10ms_t tmr10ms)
+{
+  logsRowEnd = (char *)logsRow;
+
+#if defined(RTCLOCK)
+  {
+    static struct gtm utm;
+    static gtime_t lastRtcTime = 0;
+    if (g_rtcTime != lastRtcTime) {
+      lastRtcTime = g_rtcTime;
+      gettime(&utm);
+    }
+    logsPrintf("%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+  }
+#else
+  logsPrintf("%d,", tmr10ms);
+#endif
+
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    if (isTelemetryFieldAvailable(i)) {
+      TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      TelemetryItem & telemetryItem = telemetryItems[i];
+      if (sensor.logs) {
+        if (sensor.unit == UNIT_GPS) {
+          if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
+            div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
+            if (telemetryItem.gps.latitude < 0) logsPrintf("-");
+            logsPrintf("%d.%06d ", abs(qr.quot), abs(qr.rem));
+            qr = div((int)telemetryItem.gps.longitude, 1000000);
+            if (telemetryItem.gps.longitude < 0) logsPrintf("-");
+            logsPrintf("%d.%06d,", abs(qr.quot), abs(qr.rem));
+          }
+          else {
+            logsPrintf(",");
+          }
+        }
+        else if (sensor.unit == UNIT_DATETIME) {
+          logsPrintf("%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
+        }
+        else if (sensor.unit == UNIT_TEXT) {
+          logsPrintf("\"%.*s\",", (int)sizeof(telemetryItem.text), telemetryItem.text);
+        }
+        else if (sensor.prec == 2) {
+          div_t qr = div((int)telemetryItem.value, 100);
+          if (telemetryItem.value < 0) logsPrintf("-");
+          logsPrintf("%d.%02d,", abs(qr.quot), abs(qr.rem));
+        }
+        else if (sensor.prec == 1) {
+          div_t qr = div((int)telemetryItem.value, 10);
+          if (telemetryItem.value < 0) logsPrintf("-");
+          logsPrintf("%d.%d,", abs(qr.quot), abs(qr.rem));
+        }
+        else {
+          logsPrintf("%d,", (int)telemetryItem.value);
+        }
+      }
+    }
+  }
+
+  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
+  auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
+
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    logsPrintf("%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
+  }
+
+  n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
+  offset = adcGetInputOffset(ADC_INPUT_POT);
+
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    if (IS_POT_AVAILABLE(i))
+      logsPrintf("%d,", calibratedAnalogs[offset + i]);
+  }
+
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    if (SWITCH_EXISTS(i)) {
+      logsPrintf("%d,", getSwitchState(i));
+    }
+  }
+  logsPrintf("0x%08X%08X,", (unsigned)getLogicalSwitchesStates(32),
+             (unsigned)getLogicalSwitchesStates(0));
+
+  for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
+    logsPrintf("%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
+  }
+
+  div_t qr = div(g_vbat100mV, 10);
+  logsPrintf("%d.%d\n", abs(qr.quot), abs(qr.rem));
+
+  return logsRowEnd - (char *)logsRow;
+}
+#endif
+
+void logsWrite()
+{
   if (!sdMounted()) {
     return;
   }
 
   if (isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0 && !usbPlugged()) {
-    #if defined(SIMU) || !defined(RTCLOCK)
     tmr10ms_t tmr10ms = get_tmr10ms();                                        // tmr10ms works in 10ms increments
+    #if defined(SIMU) || !defined(RTCLOCK)
     if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)(logDelay100ms*10)-1) {
       lastLogTime = tmr10ms;
     #else
     {
     #endif
+      logsActive = true;
 
-      bool sdCardFull = sdIsFull();
-
-      // check if file needs to be opened
-      if (!g_oLogFile.obj.fs) {
-        const char *result = sdCardFull ? STR_SDCARD_FULL_EXT : logsOpen();
+      uint32_t len = logsFormatRow(tmr10ms);
 
-        // SD card is full or file open failed
-        if (result) {
-          if (result != error_displayed) {
-            error_displayed = result;
-            POPUP_WARNING_ON_UI_TASK(result, nullptr, false);
-          }
-          return;
+      // whole rows only, the file would not be readable otherwise
+      if (logsBuffer.hasSpace(len)) {
+        for (uint32_t i = 0; i < len; i++) {
+          logsBuffer.push(logsRow[i]);
         }
       }
-
-      // check at every write cycle
-      if (sdCardFull) {
-        logsClose();  // timer is still running and code above will try to
-                      // open the file again but will fail with error
-                      // which will trigger the warning popup
-        return;
+      else {
+        logsDroppedRows++;
       }
+    }
+  }
+  else {
+    logsActive = false;
 
+    #if !defined(SIMU)
+    loggingTimerStop();
+    #endif
+  }
+}
 
-#if defined(RTCLOCK)
-      {
-        static struct gtm utm;
-        static gtime_t lastRtcTime = 0;
-        if (g_rtcTime != lastRtcTime) {
-          lastRtcTime = g_rtcTime;
-          gettime(&utm);
-        }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
-      }
-#else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
-#endif
+void logsFlush()
+{
+  if (logsBuffer.isEmpty()) {
+    if (!logsActive) {
+      logsError = nullptr;
+      logsClose();
+    }
+    return;
+  }
 
-      for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-        if (isTelemetryFieldAvailable(i)) {
-          TelemetrySensor & sensor = g_model.telemetrySensors[i];
-          TelemetryItem & telemetryItem = telemetryItems[i];
-          if (sensor.logs) {
-            if (sensor.unit == UNIT_GPS) {
-              if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
-                div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
-                qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
-              }
-              else {
-                f_printf(&g_oLogFile, ",");
-              }
-            }
-            else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
-            }
-            else if (sensor.unit == UNIT_TEXT) {
-              f_printf(&g_oLogFile, "\"%s\",", telemetryItem.text);
-            }
-            else if (sensor.prec == 2) {
-              div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
-            }
-            else if (sensor.prec == 1) {
-              div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
-            }
-            else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
-            }
-          }
-        }
-      }
+  if (!sdMounted()) {
+    logsDropRows(logsBuffer);
+    return;
+  }
+
+  bool sdCardFull = sdIsFull();
 
-      auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
-      auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
+  // check if file needs to be opened
+  if (!g_oLogFile.obj.fs) {
+    const char *result = sdCardFull ? STR_SDCARD_FULL_EXT : logsOpen();
 
-      for (uint8_t i = 0; i < n_inputs; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
+    // SD card is full or file open failed
+    if (result) {
+      if (result != logsError) {
+        logsError = result;
+        POPUP_WARNING_ON_UI_TASK(result, nullptr, false);
       }
+      logsDropRows(logsBuffer);
+      return;
+    }
+  }
 
-      n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
-      offset = adcGetInputOffset(ADC_INPUT_POT);
+  // check at every write cycle
+  if (sdCardFull) {
+    logsClose();  // code above will try to open the file again
+                  // but will fail with error which will trigger
+                  // the warning popup
+    return;
+  }
 
-      for (uint8_t i = 0; i < n_inputs; i++) {
-        if (IS_POT_AVAILABLE(i))
-          f_printf(&g_oLogFile, "%d,", calibratedAnalogs[offset + i]);
-      }
+  if (!logsWriteBuffer(logsBuffer, &g_oLogFile, !logsActive)) {
+    if (!logsError) {
+      logsError = STR_SDCARD_ERROR;
+      POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
+    }
+    logsClose();
+  }
+}
 
-      for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
-        if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
-        }
-      }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32),
-               getLogicalSwitchesStates(0));
+// High rate logs: a few sources sampled by the mixer task, at most once per
+// mixer cycle, into their own binary file. The mixer task only formats the
+// row and queues it, logsHighRateFlush() writes it from the main loop.
+#define LOGS_HIGH_RATE_BUFFER_SIZE  8192
+#define LOGS_HIGH_RATE_ROW_SIZE     (6 + 4 * LOGS_HIGH_RATE_MAX_SOURCES)
+
+static Fifo<uint8_t, LOGS_HIGH_RATE_BUFFER_SIZE> logsHighRateBuffer;
+static uint8_t logsHighRateRow[LOGS_HIGH_RATE_ROW_SIZE];
+static FIL logsHighRateFile __DMA;
+static mixsrc_t logsHighRateSources[LOGS_HIGH_RATE_MAX_SOURCES];
+static uint8_t logsHighRateCount = 0;
+static uint32_t logsHighRatePeriod;      // us
+static uint32_t logsHighRateNextSample;  // us tick
+static uint32_t logsHighRateLastSample;  // us tick
+static uint64_t logsHighRateTime;        // us since the start
+static volatile bool logsHighRateOn = false;
+uint32_t logsHighRateRows = 0;
+uint32_t logsHighRateDroppedRows = 0;
+
+static void writeHighRateColumns()
+{
+  writeColumn(LOGS_COLUMN_TIME, 0, "Time");
 
-      for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-        f_printf(&g_oLogFile, "%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
-      }
+  for (uint8_t i = 0; i < logsHighRateCount; i++) {
+    mixsrc_t source = logsHighRateSources[i];
+    uint8_t prec = 0;
+    if (source >= MIXSRC_FIRST_TELEM && source <= MIXSRC_LAST_TELEM) {
+      prec = g_model.telemetrySensors[(source - MIXSRC_FIRST_TELEM) / 3].prec;
+    }
+    // without the symbol some sources are prefixed with
+    const char * name = getSourceString(source);
+    while ((uint8_t)*name >= 0x80) name++;
+    writeColumn(LOGS_COLUMN_INT32, prec, name);
+  }
+}
 
-      div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+bool logsHighRateStart(const mixsrc_t * sources, uint8_t count, uint16_t rate)
+{
+  logsHighRateStop();
 
-      if (result<0 && !error_displayed) {
-        error_displayed = STR_SDCARD_ERROR;
-        POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
-        logsClose();
-      }
+  if (count == 0 || count > LOGS_HIGH_RATE_MAX_SOURCES || rate == 0 ||
+      rate > LOGS_HIGH_RATE_MAX_RATE) {
+    return false;
+  }
+
+  mixerTaskLock();
+  memcpy(logsHighRateSources, sources, count * sizeof(mixsrc_t));
+  logsHighRateCount = count;
+  logsHighRatePeriod = 1000000 / rate;
+  logsHighRateNextSample = logsHighRateLastSample = timersGetUsTick();
+  logsHighRateTime = 0;
+  logsHighRateRows = 0;
+  logsHighRateDroppedRows = 0;
+  // a row may have been half queued when the previous session was stopped
+  logsHighRateBuffer.clear();
+  logsHighRateOn = true;
+  mixerTaskUnlock();
+
+  return true;
+}
+
+bool logsHighRateActive()
+{
+  return logsHighRateOn;
+}
+
+static void logsHighRateClose()
+{
+  if (logsHighRateFile.obj.fs && sdMounted()) {
+    if (f_close(&logsHighRateFile) != FR_OK) {
+      logsHighRateFile.obj.fs = 0;
+    }
+  }
+  logsDropRows(logsHighRateBuffer);
+}
+
+static const char * logsHighRateWrite(bool all)
+{
+  if (!logsHighRateFile.obj.fs) {
+    if (sdIsFull()) {
+      return STR_SDCARD_FULL_EXT;
+    }
+    const char * error = logsOpenFile(&logsHighRateFile, LOGS_HIGH_RATE_EXT);
+    if (error) {
+      return error;
+    }
+    if (f_size(&logsHighRateFile) == 0) {
+      writeBinaryHeader(&logsHighRateFile, 0, writeHighRateColumns);
+    }
+  }
+
+  if (!logsWriteBuffer(logsHighRateBuffer, &logsHighRateFile, all)) {
+    return STR_SDCARD_ERROR;
+  }
+
+  return nullptr;
+}
+
+void logsHighRateStop()
+{
+  // the mixer task may be queuing a row
+  mixerTaskLock();
+  logsHighRateOn = false;
+  mixerTaskUnlock();
+
+  if (!logsHighRateBuffer.isEmpty() && sdMounted()) {
+    logsHighRateWrite(true);
+  }
+  logsHighRateClose();
+}
+
+// called by the mixer task after each cycle
+void logsHighRateSample()
+{
+  if (!logsHighRateOn) {
+    return;
+  }
+
+  uint32_t now = timersGetUsTick();
+  if ((int32_t)(now - logsHighRateNextSample) < 0) {
+    return;
+  }
+
+  logsHighRateNextSample += logsHighRatePeriod;
+  if ((int32_t)(now - logsHighRateNextSample) >= 0) {
+    // more than one period late, do not try to catch up
+    logsHighRateNextSample = now + logsHighRatePeriod;
+  }
+
+  logsHighRateTime += now - logsHighRateLastSample;
+  logsHighRateLastSample = now;
+
+  uint8_t * p = logsHighRateRow;
+  p = putValue(p, logsHighRateTime / 1000000, 4);
+  p = putValue(p, (logsHighRateTime / 1000) % 1000, 2);
+  for (uint8_t i = 0; i < logsHighRateCount; i++) {
+    p = putValue(p, getValue(logsHighRateSources[i]), 4);
+  }
+
+  uint32_t len = p - logsHighRateRow;
+  if (logsHighRateBuffer.hasSpace(len)) {
+    for (uint32_t i = 0; i < len; i++) {
+      logsHighRateBuffer.push(logsHighRateRow[i]);
     }
+    logsHighRateRows++;
   }
   else {
-    error_displayed = nullptr;
-    logsClose();
-    
-    #if !defined(SIMU)
-    loggingTimerStop();
-    #endif
+    logsHighRateDroppedRows++;
+  }
+}
+
+void logsHighRateFlush()
+{
+  if (logsHighRateBuffer.isEmpty()) {
+    return;
+  }
+
+  if (!sdMounted()) {
+    logsDropRows(logsHighRateBuffer);
+    return;
+  }
+
+  const char * error = logsHighRateWrite(false);
+  if (error) {
+    // the next rows would be lost as well
+    POPUP_WARNING_ON_UI_TASK(error, nullptr, false);
+    logsHighRateOn = false;
+    logsHighRateClose();
   }
 }
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Binary log format (firmwares built with LOGS_BINARY), also read by
+// Companion. All the values are little endian.
+//
+// Header:
+//   char     magic[4]   "ELOG"
+//   uint8_t  version
+//   uint8_t  flags
+//   uint16_t columns
+//   uint16_t rowSize
+// followed by one descriptor per column:
+//   uint8_t  type       LogsColumnType
+//   uint8_t  prec       number of decimals
+//   char     name[]     zero terminated, unit included, e.g. "RxBt(V)"
+// then fixed size rows, one field per column.
+
+#define LOGS_BINARY_MAGIC        "ELOG"
+#define LOGS_BINARY_VERSION      1
+#define LOGS_BINARY_HEADER_SIZE  10
+
+// the time column holds the real time clock instead of the time since boot
+#define LOGS_BINARY_FLAG_RTC     0x01
+
+#define LOGS_BINARY_TEXT_LEN     16
+
+enum LogsColumnType {
+  LOGS_COLUMN_TIME,      // uint32_t seconds, uint16_t milliseconds
+  LOGS_COLUMN_INT8,
+  LOGS_COLUMN_INT16,
+  LOGS_COLUMN_INT32,
+  LOGS_COLUMN_GPS,       // int32_t latitude, int32_t longitude, 1/1000000 deg
+  LOGS_COLUMN_DATETIME,  // uint16_t year, uint8_t month, day, hour, min, sec
+  LOGS_COLUMN_TEXT,      // LOGS_BINARY_TEXT_LEN chars, zero padded
+  LOGS_COLUMN_BITS64,    // logical switches, LS1 is bit 0
+  LOGS_COLUMN_COUNT
+};
+
+inline uint8_t logsColumnSize(uint8_t type)
+{
+  static const uint8_t sizes[LOGS_COLUMN_COUNT] = {
+    6, 1, 2, 4, 8, 7, LOGS_BINARY_TEXT_LEN, 8,
+  };
+  return type < LOGS_COLUMN_COUNT ? sizes[type] : 0;
+}
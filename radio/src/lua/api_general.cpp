@@ -32,6 +32,8 @@
 #include "hal/rotary_encoder.h"
 #include "switches.h"
 #include "input_mapping.h"
+#include "mixer_scheduler.h"
+#include "mixer_stats.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -444,15 +446,75 @@ static bool _searchSingleFields(const char* name, LuaField& field,
   return false;
 }
 
-/**
-  Return field data for a given field name
-*/
-bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
+// luaSingleFields indexes sorted by id, for luaFindFieldById()
+static uint8_t luaSingleFieldsById[DIM(luaSingleFields)];
+static bool luaSingleFieldsSorted = false;
+
+static void _sortSingleFields()
 {
-  auto len = strlen(name);
-  strncpy(field.name, name, sizeof(field.name) - 1);
-  field.name[sizeof(field.name) - 1] = '\0';
+  // fields with the same id stay in their order
+  for (uint8_t n = 0; n < DIM(luaSingleFields); n++) {
+    uint8_t pos = n;
+    while (pos > 0 && luaSingleFields[luaSingleFieldsById[pos - 1]].id > luaSingleFields[n].id) {
+      luaSingleFieldsById[pos] = luaSingleFieldsById[pos - 1];
+      pos--;
+    }
+    luaSingleFieldsById[pos] = n;
+  }
+  luaSingleFieldsSorted = true;
+}
+
+// Scripts ask for the same sources on each run, so the names lookups are
+// cached. The telemetry sensors names depend on the model: these results, and
+// the names not found, are only valid for one telemetrySensorsVersion().
+#if defined(COLORLCD)
+  #define LUA_FIELDS_CACHE_SIZE  64
+#else
+  #define LUA_FIELDS_CACHE_SIZE  32
+#endif
 
+struct LuaFieldsCacheEntry {
+  char name[sizeof(LuaField::name)];
+  uint16_t id;      // MIXSRC_NONE if not found
+  uint8_t sensors;  // 0 if it does not depend on the sensors
+};
+
+static LuaFieldsCacheEntry luaFieldsCache[LUA_FIELDS_CACHE_SIZE];
+
+static LuaFieldsCacheEntry & _getFieldsCacheEntry(const char * name)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  while (*name) {
+    hash = (hash ^ (uint8_t)*name++) * 16777619u;
+  }
+  return luaFieldsCache[(hash ^ (hash >> 16)) & (LUA_FIELDS_CACHE_SIZE - 1)];
+}
+
+static bool _isFieldsCacheEntryValid(const LuaFieldsCacheEntry & entry,
+                                     const char * name, uint8_t sensors)
+{
+  if (strcmp(entry.name, name))
+    return false;
+  if (entry.sensors == 0)
+    return true;
+  if (entry.sensors != sensors)
+    return false;
+  if (entry.id == MIXSRC_NONE)
+    return true;
+
+  // the label may have been modified without telemetrySensorsChanged()
+  static const char suffixes[] = {'\0', '-', '+'};
+  div_t qr = div(entry.id - MIXSRC_FIRST_TELEM, 3);
+  const char* sensorName = g_model.telemetrySensors[qr.quot].label;
+  int len = strnlen(sensorName, TELEM_LABEL_LEN);
+  return isTelemetryFieldAvailable(qr.quot) && !strncmp(sensorName, name, len) &&
+         name[len] == suffixes[qr.rem] && (qr.rem == 0 || name[len + 1] == '\0');
+}
+
+static bool _findFixedField(const char * name, size_t len, LuaField & field,
+                            unsigned int flags)
+{
   // hardware specific inputs
   if (_searchSingleFields(name, field, flags, _lua_inputs, DIM(_lua_inputs)))
     return true;
@@ -514,7 +576,11 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
     }
   }
 
-  // search in telemetry
+  return false;
+}
+
+static bool _findTelemetryField(const char * name, LuaField & field)
+{
   field.desc[0] = '\0';
   for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
     if (isTelemetryFieldAvailable(i)) {
@@ -523,22 +589,54 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
       if (!strncmp(sensorName, name, len)) {
         if (name[len] == '\0') {
           field.id = MIXSRC_FIRST_TELEM + 3 * i;
-          field.desc[0] = '\0';
           return true;
         } else if (name[len] == '-' && name[len + 1] == '\0') {
           field.id = MIXSRC_FIRST_TELEM + 3 * i + 1;
-          field.desc[0] = '\0';
           return true;
         } else if (name[len] == '+' && name[len + 1] == '\0') {
           field.id = MIXSRC_FIRST_TELEM + 3 * i + 2;
-          field.desc[0] = '\0';
           return true;
         }
       }
     }
   }
 
-  return false;  // not found
+  return false;
+}
+
+/**
+  Return field data for a given field name
+*/
+bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
+{
+  auto len = strlen(name);
+  strncpy(field.name, name, sizeof(field.name) - 1);
+  field.name[sizeof(field.name) - 1] = '\0';
+
+  // descriptions are not cached
+  if ((flags & FIND_FIELD_DESC) || len == 0 || len >= sizeof(field.name)) {
+    return _findFixedField(name, len, field, flags) ||
+           _findTelemetryField(name, field);
+  }
+
+  uint8_t sensors = telemetrySensorsVersion();
+  LuaFieldsCacheEntry & entry = _getFieldsCacheEntry(name);
+  if (_isFieldsCacheEntryValid(entry, name, sensors)) {
+    field.id = entry.id;
+    field.desc[0] = '\0';
+    return entry.id != MIXSRC_NONE;
+  }
+
+  bool found = _findFixedField(name, len, field, flags);
+  entry.sensors = 0;
+  if (!found) {
+    found = _findTelemetryField(name, field);
+    entry.sensors = sensors;
+  }
+  entry.id = (found ? field.id : MIXSRC_NONE);
+  strcpy(entry.name, name);
+
+  return found;
 }
 
 // Return field data for a given field id
@@ -548,16 +646,28 @@ bool luaFindFieldById(int id, LuaField & field, unsigned int flags)
   field.name[sizeof(field.name) - 1] = '\0';
   field.desc[0] = '\0';
 
-  // TODO better search method (binary lookup)
-  for (unsigned int n = 0; n < DIM(luaSingleFields); ++n) {
-    if (id == luaSingleFields[n].id) {
-      strncpy(field.name, luaSingleFields[n].name, sizeof(field.name) - 1);
-      if (flags & FIND_FIELD_DESC) {
-        strncpy(field.desc, luaSingleFields[n].desc, sizeof(field.desc) - 1);
-        field.desc[sizeof(field.desc) - 1] = '\0';
-      }
-      return true;
+  if (!luaSingleFieldsSorted) {
+    _sortSingleFields();
+  }
+
+  // binary search of the first single field with this id
+  unsigned int first = 0, last = DIM(luaSingleFields);
+  while (first < last) {
+    unsigned int mid = (first + last) / 2;
+    if (luaSingleFields[luaSingleFieldsById[mid]].id < id)
+      first = mid + 1;
+    else
+      last = mid;
+  }
+  if (first < DIM(luaSingleFields) &&
+      id == luaSingleFields[luaSingleFieldsById[first]].id) {
+    const LuaSingleField & singleField = luaSingleFields[luaSingleFieldsById[first]];
+    strncpy(field.name, singleField.name, sizeof(field.name) - 1);
+    if (flags & FIND_FIELD_DESC) {
+      strncpy(field.desc, singleField.desc, sizeof(field.desc) - 1);
+      field.desc[sizeof(field.desc) - 1] = '\0';
     }
+    return true;
   }
 
   // search in multiples
@@ -585,24 +695,13 @@ bool luaFindFieldById(int id, LuaField & field, unsigned int flags)
     }
   }
 
-  // search in telemetry
-  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
-    if (isTelemetryFieldAvailable(i)) {
-      int index = id - (MIXSRC_FIRST_TELEM + 3 * i);
-      if (0 <= index && index < 3) {
-        const char* sensorName = g_model.telemetrySensors[i].label;
-        switch (index) {
-          case 0:
-            snprintf(field.name, sizeof(field.name), "%s", sensorName);
-            break;
-          case 1:
-            snprintf(field.name, sizeof(field.name), "%s-", sensorName);
-            break;
-          case 2:
-            snprintf(field.name, sizeof(field.name), "%s+", sensorName);
-        }
-      }
-    }
+  // telemetry sensors past the "telem" fields: only the name is set
+  int index = id - MIXSRC_FIRST_TELEM;
+  if (0 <= index && index < 3 * MAX_TELEMETRY_SENSORS &&
+      isTelemetryFieldAvailable(index / 3)) {
+    static const char suffixes[][2] = {"", "-", "+"};
+    snprintf(field.name, sizeof(field.name), "%.*s%s", TELEM_LABEL_LEN,
+             g_model.telemetrySensors[index / 3].label, suffixes[index % 3]);
   }
 
   return false;  // not found
@@ -726,6 +825,59 @@ static int luaGetValue(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function getValues(sources [, values])
+
+Returns the values of several sources in one call.
+
+@param sources (table) array of sources, each one an index (number) or
+a name (string), as accepted by `getValue()`. Using indexes, obtained once
+with `getFieldInfo` or `getSourceIndex`, avoids looking up the names.
+
+@param values (table) optional table that receives the values. Passing the
+same table on each call avoids creating a new one each time.
+
+@retval table `values`, or a new table when it is not given: the value of
+`sources[i]` is stored in `values[i]`, exactly as `getValue()` returns it.
+
+@status current Introduced in 2.10.0
+
+@notice A dashboard widget calls this once per refresh instead of calling
+`getValue()` for each of the values it displays.
+*/
+static int luaGetValues(lua_State * L)
+{
+  luaL_checktype(L, 1, LUA_TTABLE);
+  int count = lua_rawlen(L, 1);
+
+  if (lua_istable(L, 2)) {
+    lua_settop(L, 2);
+  }
+  else {
+    lua_settop(L, 1);
+    lua_createtable(L, count, 0);
+  }
+
+  for (int i = 1; i <= count; i++) {
+    int src = MIXSRC_NONE;
+    lua_rawgeti(L, 1, i);
+    if (lua_type(L, -1) == LUA_TNUMBER) {
+      src = lua_tointeger(L, -1);
+    }
+    else if (lua_type(L, -1) == LUA_TSTRING) {
+      LuaField field;
+      if (luaFindFieldByName(lua_tostring(L, -1), field)) {
+        src = field.id;
+      }
+    }
+    lua_pop(L, 1);
+    luaGetValueAndPush(L, src);
+    lua_rawseti(L, 2, i);
+  }
+
+  return 1;
+}
+
 /*luadoc
 @function getSourceValue(source)
 
@@ -1894,10 +2046,14 @@ static int luaSetTelemetryValue(lua_State * L)
                                   value, unit, prec);
     if (index >= 0) {
       TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+      const char * label = (name ? name : name_buf);
+      if (strncmp(telemetrySensor.label, label, TELEM_LABEL_LEN)) {
+        telemetrySensorsChanged();
+      }
       telemetrySensor.id = id;
       telemetrySensor.subId = subId;
       telemetrySensor.instance = instance;
-      telemetrySensor.init(name ? name: name_buf, unit, prec);
+      telemetrySensor.init(label, unit, prec);
       lua_pushboolean(L, true);
     } else {
       lua_pushboolean(L, false);
@@ -2084,6 +2240,151 @@ static int luaGetUsage(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function getMixerStats([reset])
+
+Get the mixer cycle timings collected since boot or the last reset.
+
+@param reset (boolean) reset the statistics after reading them
+
+@retval table with elements:
+* `period` (number) current mixer period in us
+* `cycles` (number) number of mixer cycles
+* `overruns` (number) cycles longer than the mixer period
+* `jitterMax` (number) maximum jitter in us
+* `stages` (table) `last` and `max` duration in us of `adc`, `switches`,
+  `mixes`, `pulses` and `periodic`
+* `cycle` (table) histogram of the cycle duration: element 1 counts 0us cycles,
+  element n counts cycles from 2^(n-2) to 2^(n-1) us, the last one all longer cycles
+* `jitter` (table) histogram of the distance between two cycle starts and the period,
+  same layout as `cycle`
+
+@status current Introduced in 2.10.0
+*/
+static void luaPushMixerHistogram(lua_State * L, const char * name, const uint32_t * histogram)
+{
+  lua_pushstring(L, name);
+  lua_newtable(L);
+  for (int i = 0; i < MIXER_STATS_BUCKETS; i++) {
+    lua_pushunsigned(L, histogram[i]);
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_settable(L, -3);
+}
+
+static int luaGetMixerStats(lua_State * L)
+{
+  bool reset = lua_toboolean(L, 1);
+
+  lua_newtable(L);
+  lua_pushtableinteger(L, "period", getMixerSchedulerPeriod());
+  lua_pushtableinteger(L, "cycles", mixerStats.cycles);
+  lua_pushtableinteger(L, "overruns", mixerStats.overruns);
+  lua_pushtableinteger(L, "jitterMax", mixerStats.jitterMax);
+
+  lua_pushstring(L, "stages");
+  lua_newtable(L);
+  for (int i = 0; i < MIXER_STAGE_COUNT; i++) {
+    lua_pushstring(L, mixerStatsStageName(i));
+    lua_newtable(L);
+    lua_pushtableinteger(L, "last", mixerStats.stageLast[i]);
+    lua_pushtableinteger(L, "max", mixerStats.stageMax[i]);
+    lua_settable(L, -3);
+  }
+  lua_settable(L, -3);
+
+  luaPushMixerHistogram(L, "cycle", mixerStats.cycleHistogram);
+  luaPushMixerHistogram(L, "jitter", mixerStats.jitterHistogram);
+
+  if (reset) {
+    mixerStatsReset();
+  }
+  return 1;
+}
+
+/*luadoc
+@function startHighRateLog(sources, rate)
+
+Start logging a few sources at every mixer cycle, up to `rate` times per
+second, into a binary log file named like the normal log file with a `-hr.bin`
+suffix. A running high rate log is stopped first.
+
+@param sources (table) up to 16 sources, as indexes (number) or names (string)
+
+@param rate (number) samples per second, 1 to 250
+
+@retval boolean true if the log was started, false if a source does not exist
+or the parameters are out of range
+
+@status current Introduced in 2.10.0
+*/
+static int luaStartHighRateLog(lua_State * L)
+{
+  luaL_checktype(L, 1, LUA_TTABLE);
+  int rate = luaL_checkinteger(L, 2);
+
+  mixsrc_t sources[LOGS_HIGH_RATE_MAX_SOURCES];
+  uint8_t count = 0;
+  bool valid = true;
+
+  for (lua_pushnil(L); lua_next(L, 1); lua_pop(L, 1)) {
+    int src = MIXSRC_NONE;
+    if (lua_type(L, -1) == LUA_TNUMBER) {
+      src = lua_tointeger(L, -1);
+    }
+    else if (lua_type(L, -1) == LUA_TSTRING) {
+      LuaField field;
+      if (luaFindFieldByName(lua_tostring(L, -1), field)) {
+        src = field.id;
+      }
+    }
+    if (src <= MIXSRC_NONE || src > MIXSRC_LAST_TELEM ||
+        count >= LOGS_HIGH_RATE_MAX_SOURCES) {
+      valid = false;
+    }
+    else {
+      sources[count++] = src;
+    }
+  }
+
+  // checked before it is narrowed to the uint16_t of logsHighRateStart()
+  lua_pushboolean(L, valid && rate > 0 && rate <= LOGS_HIGH_RATE_MAX_RATE &&
+                         logsHighRateStart(sources, count, rate));
+  return 1;
+}
+
+/*luadoc
+@function stopHighRateLog()
+
+Stop the high rate log and write the remaining samples.
+
+@status current Introduced in 2.10.0
+*/
+static int luaStopHighRateLog(lua_State * L)
+{
+  logsHighRateStop();
+  return 0;
+}
+
+/*luadoc
+@function getHighRateLogStats()
+
+@retval table with elements:
+* `active` (boolean) a high rate log is running
+* `rows` (number) samples queued since the log was started
+* `dropped` (number) samples lost because the SD card did not keep up
+
+@status current Introduced in 2.10.0
+*/
+static int luaGetHighRateLogStats(lua_State * L)
+{
+  lua_newtable(L);
+  lua_pushtableboolean(L, "active", logsHighRateActive());
+  lua_pushtableinteger(L, "rows", logsHighRateRows);
+  lua_pushtableinteger(L, "dropped", logsHighRateDroppedRows);
+  return 1;
+}
+
 /*luadoc
 @function getAvailableMemory()
 
@@ -2791,6 +3092,7 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( getRotEncSpeed, luaGetRotEncSpeed )
   LROT_FUNCENTRY( getRotEncMode, luaGetRotEncMode )
   LROT_FUNCENTRY( getValue, luaGetValue )
+  LROT_FUNCENTRY( getValues, luaGetValues )
   LROT_FUNCENTRY( getOutputValue, luaGetOutputValue )
   LROT_FUNCENTRY( getSourceValue, luaGetSourceValue )
   LROT_FUNCENTRY( getTrainerStatus, luaGetTrainerStatus )
@@ -2817,6 +3119,10 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( chdir, luaChdir )
   LROT_FUNCENTRY( loadScript, luaLoadScript )
   LROT_FUNCENTRY( getUsage, luaGetUsage )
+  LROT_FUNCENTRY( getMixerStats, luaGetMixerStats )
+  LROT_FUNCENTRY( startHighRateLog, luaStartHighRateLog )
+  LROT_FUNCENTRY( stopHighRateLog, luaStopHighRateLog )
+  LROT_FUNCENTRY( getHighRateLogStats, luaGetHighRateLogStats )
   LROT_FUNCENTRY( getAvailableMemory, luaGetAvailableMemory )
   LROT_FUNCENTRY( resetGlobalTimer, luaResetGlobalTimer )
 #if LCD_DEPTH > 1 && !defined(COLORLCD)
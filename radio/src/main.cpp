@@ -30,6 +30,10 @@
   #include "theme.h"
 #endif
 
+#if defined(STORAGE_MODELSLIST)
+  #include "storage/modelslist.h"
+#endif
+
 #if defined(CLI)
   #include "cli.h"
 #endif
@@ -534,6 +538,13 @@ void perMain()
     #else
       logsWrite();         // call logsWrite the old way for simu
     #endif
+    logsFlush();
+    logsHighRateFlush();
+
+#if defined(STORAGE_MODELSLIST)
+    // models changed since the last boot, one at a time
+    modelslist.updateNextModel();
+#endif
   }
 
   handleUsbConnection();
@@ -543,6 +554,7 @@ void perMain()
 #endif
 
   checkTrainerSettings();
+  curvesCacheUpdate();
   periodicTick();
   DEBUG_TIMER_STOP(debugTimerPerMain1);
 
@@ -652,7 +652,7 @@ int getSourceTrimValue(int source, int stickValue=0)
 
 uint8_t mixerCurrentFlightMode;
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t channels)
 {
   evalInputs(mode);
 
@@ -727,277 +727,396 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
   }
 #endif
 
-  memclear(chans, sizeof(chans)); // all outputs to 0
+  if (channels == MIX_ALL_CHANNELS)
+    memclear(chans, sizeof(chans)); // all outputs to 0
 
   //========== MIXER LOOP ===============
   uint8_t lv_mixWarning = 0;
 
-  uint8_t pass = 0;
+  // active lines only, with source channels computed first
+  const MixPlan & plan = getMixPlan();
 
-  bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
+  for (uint8_t k=0; k<plan.count; k++) {
+    uint8_t i = plan.lines[k];
+    MixData * md = mixAddress(i);
 
-  do {
-    bitfield_channels_t passDirtyChannels = 0;
-
-    for (uint8_t i=0; i<MAX_MIXERS; i++) {
-      if (mode == e_perout_mode_normal && pass == 0)
-        swOn[i].activeMix = 0;
-
-      MixData * md = mixAddress(i);
-
-      if (md->srcRaw == 0)
-#if defined(COLORLCD)
-        continue;
-#else
-        break;
-#endif
-
-      mixsrc_t stickIndex = md->srcRaw - MIXSRC_FIRST_STICK;
+    // other channels keep their current value
+    if (!(channels & ((bitfield_channels_t)1 << md->destCh)))
+      continue;
 
-      if (!(dirtyChannels & ((bitfield_channels_t)1 << md->destCh)))
-        continue;
+    if (mode == e_perout_mode_normal)
+      swOn[i].activeMix = 0;
 
-      // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
-      if (i == 0 || md->destCh != (md-1)->destCh)
-        chans[md->destCh] = 0;
+    // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
+    if (i == 0 || md->destCh != (md-1)->destCh)
+      chans[md->destCh] = 0;
 
-      //========== FLIGHT MODE && SWITCH =====
-      bool mixCondition = (md->flightModes != 0 || md->swtch);
-      delayval_t mixEnabled = (!(md->flightModes & (1 << mixerCurrentFlightMode)) && getSwitch(md->swtch)) ? DELAY_POS_MARGIN+1 : 0;
+    //========== FLIGHT MODE && SWITCH =====
+    bool mixCondition = (md->flightModes != 0 || md->swtch);
+    delayval_t mixEnabled = (!(md->flightModes & (1 << mixerCurrentFlightMode)) && getSwitch(md->swtch)) ? DELAY_POS_MARGIN+1 : 0;
 
 #define MIXER_LINE_DISABLE()   (mixCondition = true, mixEnabled = 0)
 
-      if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER && !is_trainer_connected()) {
-        MIXER_LINE_DISABLE();
-      }
+    if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER && !is_trainer_connected()) {
+      MIXER_LINE_DISABLE();
+    }
 
 #if defined(LUA_MODEL_SCRIPTS)
-      // disable mixer if Lua script is used as source and script was killed
-      if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA) {
-        div_t qr = div(md->srcRaw-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-        if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
-          MIXER_LINE_DISABLE();
-        }
+    // disable mixer if Lua script is used as source and script was killed
+    if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA) {
+      div_t qr = div(md->srcRaw-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
+      if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
+        MIXER_LINE_DISABLE();
       }
+    }
 #endif
 
-      //========== VALUE ===============
-      getvalue_t v = 0;
-      if (mode > e_perout_mode_inactive_flight_mode) {
-        if (mixEnabled)
-          v = getValue(md->srcRaw);
-        else
-          continue;
+    //========== VALUE ===============
+    getvalue_t v = 0;
+    if (mode > e_perout_mode_inactive_flight_mode) {
+      if (mixEnabled)
+        v = getValue(plan.sources[i]);
+      else
+        continue;
+    }
+    else {
+      v = getValue(plan.sources[i]);
+      if (plan.currentChannelSources & ((uint64_t)1 << i)) {
+        // source channel has already been computed in this pass,
+        // otherwise use its value from the previous mixer cycle
+        v = chans[md->srcRaw - MIXSRC_FIRST_CH] >> 8;
       }
-      else {
-        mixsrc_t srcRaw = MIXSRC_FIRST_STICK + stickIndex;
-        v = getValue(srcRaw);
-        srcRaw -= MIXSRC_FIRST_CH;
-        if (srcRaw <= MIXSRC_LAST_CH-MIXSRC_FIRST_CH && md->destCh != srcRaw) {
-          if (dirtyChannels & ((bitfield_channels_t)1 << srcRaw) & (passDirtyChannels|~(((bitfield_channels_t) 1 << md->destCh)-1)))
-            passDirtyChannels |= (bitfield_channels_t) 1 << md->destCh;
-          if (srcRaw < md->destCh || pass > 0)
-            v = chans[srcRaw] >> 8;
-        }
-        if (!mixCondition) {
-          mixEnabled = v;
-        }
+      if (!mixCondition) {
+        mixEnabled = v;
       }
+    }
 
-      bool applyOffsetAndCurve = true;
-
-      //========== DELAYS ===============
-      delayval_t _swOn = swOn[i].now;
-      delayval_t _swPrev = swOn[i].prev;
-      bool swTog = (mixEnabled > _swOn+DELAY_POS_MARGIN || mixEnabled < _swOn-DELAY_POS_MARGIN);
-      if (mode == e_perout_mode_normal && swTog) {
-        if (!swOn[i].delay)
-          _swPrev = _swOn;
-        swOn[i].delay = (mixEnabled > _swOn ? md->delayUp : md->delayDown) * 10;
-        swOn[i].now = mixEnabled;
-        swOn[i].prev = _swPrev;
-      }
-      if (mode == e_perout_mode_normal && swOn[i].delay > 0) {
-        swOn[i].delay = max<int16_t>(0, (int16_t)swOn[i].delay - tick10ms);
-        if (!mixCondition)
-          v = _swPrev;
-        else if (mixEnabled)
-          continue;
+    bool applyOffsetAndCurve = true;
+
+    //========== DELAYS ===============
+    delayval_t _swOn = swOn[i].now;
+    delayval_t _swPrev = swOn[i].prev;
+    bool swTog = (mixEnabled > _swOn+DELAY_POS_MARGIN || mixEnabled < _swOn-DELAY_POS_MARGIN);
+    if (mode == e_perout_mode_normal && swTog) {
+      if (!swOn[i].delay)
+        _swPrev = _swOn;
+      swOn[i].delay = (mixEnabled > _swOn ? md->delayUp : md->delayDown) * 10;
+      swOn[i].now = mixEnabled;
+      swOn[i].prev = _swPrev;
+    }
+    if (mode == e_perout_mode_normal && swOn[i].delay > 0) {
+      swOn[i].delay = max<int16_t>(0, (int16_t)swOn[i].delay - tick10ms);
+      if (!mixCondition)
+        v = _swPrev;
+      else if (mixEnabled)
+        continue;
+    }
+    else {
+      if (mode==e_perout_mode_normal) {
+        swOn[i].now = swOn[i].prev = mixEnabled;
       }
-      else {
-        if (mode==e_perout_mode_normal) {
-          swOn[i].now = swOn[i].prev = mixEnabled;
-        }
-        if (!mixEnabled) {
-          if ((md->speedDown || md->speedUp) && md->mltpx!=MLTPX_REPL) {
-            if (mixCondition) {
-              v = (md->mltpx == MLTPX_ADD ? 0 : RESX);
-              applyOffsetAndCurve = false;
-            }
-          }
-          else if (mixCondition) {
-            continue;
+      if (!mixEnabled) {
+        if ((md->speedDown || md->speedUp) && md->mltpx!=MLTPX_REPL) {
+          if (mixCondition) {
+            v = (md->mltpx == MLTPX_ADD ? 0 : RESX);
+            applyOffsetAndCurve = false;
           }
         }
+        else if (mixCondition) {
+          continue;
+        }
       }
+    }
 
-      if (mode==e_perout_mode_normal && (!mixCondition || mixEnabled || swOn[i].delay)) {
-        if (md->mixWarn)
-          lv_mixWarning |= 1 << (md->mixWarn - 1);
-        swOn[i].activeMix = true;
-      }
+    if (mode==e_perout_mode_normal && (!mixCondition || mixEnabled || swOn[i].delay)) {
+      if (md->mixWarn)
+        lv_mixWarning |= 1 << (md->mixWarn - 1);
+      swOn[i].activeMix = true;
+    }
 
-      if (applyOffsetAndCurve) {
-        bool applyTrims = !(mode & e_perout_mode_notrims);
-        if (!applyTrims && g_model.thrTrim) {
-          auto origin = getSourceTrimOrigin(md->srcRaw);
-          if (origin == g_model.getThrottleStickTrimSource() - MIXSRC_FIRST_TRIM) {
-            applyTrims = true;
-          }
-        }
-        if (applyTrims && md->carryTrim == 0) {
-          v += getSourceTrimValue(md->srcRaw, v);
+    if (applyOffsetAndCurve) {
+      bool applyTrims = !(mode & e_perout_mode_notrims);
+      if (!applyTrims && g_model.thrTrim) {
+        auto origin = getSourceTrimOrigin(md->srcRaw);
+        if (origin == g_model.getThrottleStickTrimSource() - MIXSRC_FIRST_TRIM) {
+          applyTrims = true;
         }
       }
+      if (applyTrims && md->carryTrim == 0) {
+        v += getSourceTrimValue(md->srcRaw, v);
+      }
+    }
 
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-      weight = calc100to256_16Bits(weight);
-      //========== SPEED ===============
-      // now its on input side, but without weight compensation. More like other remote controls
-      // lower weight causes slower movement
+    int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+    weight = calc100to256_16Bits(weight);
+    //========== SPEED ===============
+    // now its on input side, but without weight compensation. More like other remote controls
+    // lower weight causes slower movement
 
-      if (mode <= e_perout_mode_inactive_flight_mode && (md->speedUp || md->speedDown)) { // there are delay values
+    if (mode <= e_perout_mode_inactive_flight_mode && (md->speedUp || md->speedDown)) { // there are delay values
 #define DEL_MULT_SHIFT 8
-        // we recale to a mult 256 higher value for calculation
-        int32_t tact = act[i];
-        int16_t diff = v - (tact>>DEL_MULT_SHIFT);
-        if (diff) {
-          // open.20.fsguruh: speed is defined in % movement per second; In menu we specify the full movement (-100% to 100%) = 200% in total
-          // the unit of the stored value is the value from md->speedUp or md->speedDown * 0.1s; e.g. value 4 means 0.4 seconds
-          // because we get a tick each 10msec, we need 100 ticks for one second
-          // the value in md->speedXXX gives the time it should take to do a full movement from -100 to 100 therefore 200%. This equals 2048 in recalculated internal range
-          if (tick10ms || !s_mixer_first_run_done) {
-            // only if already time is passed add or substract a value according the speed configured
-            int32_t rate = (int32_t) tick10ms << (DEL_MULT_SHIFT+11);  // = DEL_MULT*2048*tick10ms
-            // rate equals a full range for one second; if less time is passed rate is accordingly smaller
-            // if one second passed, rate would be 2048 (full motion)*256(recalculated weight)*100(100 ticks needed for one second)
-            int32_t currentValue = ((int32_t) v<<DEL_MULT_SHIFT);
-            if (diff > 0) {
-              if (s_mixer_first_run_done && md->speedUp > 0) {
-                // if a speed upwards is defined recalculate the new value according configured speed; the higher the speed the smaller the add value is
-                int32_t newValue = tact+rate/((int16_t)10*md->speedUp);
-                if (newValue<currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
-              }
+      // we recale to a mult 256 higher value for calculation
+      int32_t tact = act[i];
+      int16_t diff = v - (tact>>DEL_MULT_SHIFT);
+      if (diff) {
+        // open.20.fsguruh: speed is defined in % movement per second; In menu we specify the full movement (-100% to 100%) = 200% in total
+        // the unit of the stored value is the value from md->speedUp or md->speedDown * 0.1s; e.g. value 4 means 0.4 seconds
+        // because we get a tick each 10msec, we need 100 ticks for one second
+        // the value in md->speedXXX gives the time it should take to do a full movement from -100 to 100 therefore 200%. This equals 2048 in recalculated internal range
+        if (tick10ms || !s_mixer_first_run_done) {
+          // only if already time is passed add or substract a value according the speed configured
+          int32_t rate = (int32_t) tick10ms << (DEL_MULT_SHIFT+11);  // = DEL_MULT*2048*tick10ms
+          // rate equals a full range for one second; if less time is passed rate is accordingly smaller
+          // if one second passed, rate would be 2048 (full motion)*256(recalculated weight)*100(100 ticks needed for one second)
+          int32_t currentValue = ((int32_t) v<<DEL_MULT_SHIFT);
+          if (diff > 0) {
+            if (s_mixer_first_run_done && md->speedUp > 0) {
+              // if a speed upwards is defined recalculate the new value according configured speed; the higher the speed the smaller the add value is
+              int32_t newValue = tact+rate/((int16_t)10*md->speedUp);
+              if (newValue<currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
             }
-            else {  // if is <0 because ==0 is not possible
-              if (s_mixer_first_run_done && md->speedDown > 0) {
-                // see explanation in speedUp
-                int32_t newValue = tact-rate/((int16_t)10*md->speedDown);
-                if (newValue>currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
-              }
+          }
+          else {  // if is <0 because ==0 is not possible
+            if (s_mixer_first_run_done && md->speedDown > 0) {
+              // see explanation in speedUp
+              int32_t newValue = tact-rate/((int16_t)10*md->speedDown);
+              if (newValue>currentValue) currentValue = newValue; // Endposition; prevent toggling around the destination
             }
-            act[i] = tact = currentValue;
-            // open.20.fsguruh: this implementation would save about 50 bytes code
-          } // endif tick10ms ; in case no time passed assign the old value, not the current value from source
-          v = (tact >> DEL_MULT_SHIFT);
-        }
+          }
+          act[i] = tact = currentValue;
+          // open.20.fsguruh: this implementation would save about 50 bytes code
+        } // endif tick10ms ; in case no time passed assign the old value, not the current value from source
+        v = (tact >> DEL_MULT_SHIFT);
       }
+    }
 
-      //========== CURVES ===============
-      if (applyOffsetAndCurve && md->curve.type != CURVE_REF_DIFF && md->curve.value) {
-        v = applyCurve(v, md->curve);
-      }
+    //========== CURVES ===============
+    if (applyOffsetAndCurve && md->curve.type != CURVE_REF_DIFF && md->curve.value) {
+      v = applyCurve(v, md->curve);
+    }
 
-      //========== WEIGHT ===============
-      int32_t dv = (int32_t)v * weight;
-      dv = divRoundClosest(dv, 10);
+    //========== WEIGHT ===============
+    int32_t dv = (int32_t)v * weight;
+    dv = divRoundClosest(dv, 10);
 
-      //========== OFFSET / AFTER ===============
-      if (applyOffsetAndCurve) {
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
-      }
+    //========== OFFSET / AFTER ===============
+    if (applyOffsetAndCurve) {
+      int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+      if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+    }
 
-      //========== DIFFERENTIAL =========
-      if (md->curve.type == CURVE_REF_DIFF && md->curve.value) {
-        dv = applyCurve(dv, md->curve);
-      }
+    //========== DIFFERENTIAL =========
+    if (md->curve.type == CURVE_REF_DIFF && md->curve.value) {
+      dv = applyCurve(dv, md->curve);
+    }
 
-      int32_t * ptr = &chans[md->destCh]; // Save calculating address several times
+    int32_t * ptr = &chans[md->destCh]; // Save calculating address several times
 
-      switch (md->mltpx) {
-        case MLTPX_REPL:
-          *ptr = dv;
-          if (mode == e_perout_mode_normal) {
-            for (uint8_t m=i-1; m<MAX_MIXERS && mixAddress(m)->destCh==md->destCh; m--)
-              swOn[m].activeMix = false;
-          }
-          break;
-        case MLTPX_MUL:
-          // @@@2 we have to remove the weight factor of 256 in case of 100%; now we use the new base of 256
-          dv >>= 8;
-          dv *= *ptr;
-          dv >>= RESX_SHIFT;   // same as dv /= RESXl;
-          *ptr = dv;
-          break;
-        default: // MLTPX_ADD
-          *ptr += dv; //Mixer output add up to the line (dv + (dv>0 ? 100/2 : -100/2))/(100);
-          break;
-      } // endswitch md->mltpx
+    switch (md->mltpx) {
+      case MLTPX_REPL:
+        *ptr = dv;
+        if (mode == e_perout_mode_normal) {
+          for (uint8_t m=i-1; m<MAX_MIXERS && mixAddress(m)->destCh==md->destCh; m--)
+            swOn[m].activeMix = false;
+        }
+        break;
+      case MLTPX_MUL:
+        // @@@2 we have to remove the weight factor of 256 in case of 100%; now we use the new base of 256
+        dv >>= 8;
+        dv *= *ptr;
+        dv >>= RESX_SHIFT;   // same as dv /= RESXl;
+        *ptr = dv;
+        break;
+      default: // MLTPX_ADD
+        *ptr += dv; //Mixer output add up to the line (dv + (dv>0 ? 100/2 : -100/2))/(100);
+        break;
+    } // endswitch md->mltpx
 #ifdef PREVENT_ARITHMETIC_OVERFLOW
 /*
-      // a lot of assumptions must be true, for this kind of check; not really worth for only 4 bytes flash savings
-      // this solution would save again 4 bytes flash
-      int8_t testVar=(*ptr<<1)>>24;
-      if ( (testVar!=-1) && (testVar!=0 ) ) {
-        // this devices by 64 which should give a good balance between still over 100% but lower then 32x100%; should be OK
-        *ptr >>= 6;  // this is quite tricky, reduces the value a lot but should be still over 100% and reduces flash need
-      } */
-
-
-      PACK( union u_int16int32_t {
-        struct {
-          int16_t lo;
-          int16_t hi;
-        } words_t;
-        int32_t dword;
-      });
-
-      u_int16int32_t tmp;
-      tmp.dword=*ptr;
-
-      if (tmp.dword<0) {
-        if ((tmp.words_t.hi&0xFF80)!=0xFF80) tmp.words_t.hi=0xFF86; // set to min nearly
-      }
-      else {
-        if ((tmp.words_t.hi|0x007F)!=0x007F) tmp.words_t.hi=0x0079; // set to max nearly
-      }
-      *ptr = tmp.dword;
-      // this implementation saves 18bytes flash
+    // a lot of assumptions must be true, for this kind of check; not really worth for only 4 bytes flash savings
+    // this solution would save again 4 bytes flash
+    int8_t testVar=(*ptr<<1)>>24;
+    if ( (testVar!=-1) && (testVar!=0 ) ) {
+      // this devices by 64 which should give a good balance between still over 100% but lower then 32x100%; should be OK
+      *ptr >>= 6;  // this is quite tricky, reduces the value a lot but should be still over 100% and reduces flash need
+    } */
+
+
+    PACK( union u_int16int32_t {
+      struct {
+        int16_t lo;
+        int16_t hi;
+      } words_t;
+      int32_t dword;
+    });
+
+    u_int16int32_t tmp;
+    tmp.dword=*ptr;
+
+    if (tmp.dword<0) {
+      if ((tmp.words_t.hi&0xFF80)!=0xFF80) tmp.words_t.hi=0xFF86; // set to min nearly
+    }
+    else {
+      if ((tmp.words_t.hi|0x007F)!=0x007F) tmp.words_t.hi=0x0079; // set to max nearly
+    }
+    *ptr = tmp.dword;
+    // this implementation saves 18bytes flash
 
 /*      dv=*ptr>>8;
-      if (dv>(32767-RESXl)) {
-        *ptr=(32767-RESXl)<<8;
-      } else if (dv<(-32767+RESXl)) {
-        *ptr=(-32767+RESXl)<<8;
-      }*/
-      // *ptr=limit( int32_t(int32_t(-1)<<23), *ptr, int32_t(int32_t(1)<<23));  // limit code cost 72 bytes
-      // *ptr=limit( int32_t((-32767+RESXl)<<8), *ptr, int32_t((32767-RESXl)<<8));  // limit code cost 80 bytes
+    if (dv>(32767-RESXl)) {
+      *ptr=(32767-RESXl)<<8;
+    } else if (dv<(-32767+RESXl)) {
+      *ptr=(-32767+RESXl)<<8;
+    }*/
+    // *ptr=limit( int32_t(int32_t(-1)<<23), *ptr, int32_t(int32_t(1)<<23));  // limit code cost 72 bytes
+    // *ptr=limit( int32_t((-32767+RESXl)<<8), *ptr, int32_t((32767-RESXl)<<8));  // limit code cost 80 bytes
 #endif
 
-    } //endfor mixers
+  } //endfor mixers
+
+  if (channels == MIX_ALL_CHANNELS)
+    mixWarning = lv_mixWarning;
+}
+
+
 
-    tick10ms = 0;
-    dirtyChannels &= passDirtyChannels;
+#define MAX_ACT 0xffff
 
-  } while (++pass < 5 && dirtyChannels);
+// what may differ between the flight modes being faded
+struct FadingSources {
+  uint16_t modes;
+  uint16_t gvars;
+  uint16_t trims;
+  uint32_t inputs;
+  bitfield_channels_t channels;
+};
 
-  mixWarning = lv_mixWarning;
+static bool isFlightModeMaskFading(uint16_t flightModes, const FadingSources & fading)
+{
+  flightModes &= fading.modes;
+  return flightModes && flightModes != fading.modes;
 }
 
+static bool isSwitchFading(swsrc_t swtch)
+{
+  // logical switches have one state per flight mode
+  swtch = abs(swtch);
+  return (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH) ||
+         (swtch >= SWSRC_FIRST_FLIGHT_MODE && swtch <= SWSRC_LAST_FLIGHT_MODE);
+}
 
+static bool isGVarFieldFading(int16_t x, int16_t min, int16_t max, const FadingSources & fading)
+{
+#if defined(GVARS)
+  if (GV_IS_GV_VALUE(x, min, max)) {
+    int8_t gv = GV_INDEX_CALCULATION(x, max);
+    if (gv < 0) gv = -1 - gv;
+    return fading.gvars & (1 << gv);
+  }
+#endif
+  return false;
+}
+
+static bool isCurveFading(const CurveRef & curve, const FadingSources & fading)
+{
+  return (curve.type == CURVE_REF_DIFF || curve.type == CURVE_REF_EXPO) &&
+         isGVarFieldFading(curve.value, -100, 100, fading);
+}
+
+static bool isSourceFading(mixsrc_t src, const FadingSources & fading)
+{
+  if (src >= MIXSRC_FIRST_INPUT && src <= MIXSRC_LAST_INPUT)
+    return fading.inputs & ((uint32_t)1 << (src - MIXSRC_FIRST_INPUT));
+  else if (src >= MIXSRC_FIRST_TRIM && src <= MIXSRC_LAST_TRIM)
+    return fading.trims & (1 << (src - MIXSRC_FIRST_TRIM));
+  else if (src >= MIXSRC_FIRST_LOGICAL_SWITCH && src <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return true;
+#if defined(HELI)
+  else if (src >= MIXSRC_FIRST_HELI && src <= MIXSRC_LAST_HELI)
+    return true;
+#endif
+  else if (src >= MIXSRC_FIRST_CH && src <= MIXSRC_LAST_CH)
+    return fading.channels & ((bitfield_channels_t)1 << (src - MIXSRC_FIRST_CH));
+#if defined(GVARS)
+  else if (src >= MIXSRC_FIRST_GVAR && src <= MIXSRC_LAST_GVAR)
+    return fading.gvars & (1 << (src - MIXSRC_FIRST_GVAR));
+#endif
+  return false;
+}
+
+// Channels whose output may differ between the flight modes in fadeModes.
+// The others give the same output in all of them.
+static bitfield_channels_t getFadingChannels(uint16_t fadeModes)
+{
+  FadingSources fading;
+  memclear(&fading, sizeof(fading));
+  fading.modes = fadeModes;
+
+  uint8_t first = 0;
+  while (!(fadeModes & (1 << first)))
+    first++;
+
+  for (uint8_t p = first + 1; p < MAX_FLIGHT_MODES; p++) {
+    if (!(fadeModes & (1 << p)))
+      continue;
+#if defined(GVARS)
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      if (getGVarValue(gv, p) != getGVarValue(gv, first))
+        fading.gvars |= 1 << gv;
+    }
+#endif
+    for (uint8_t t = 0; t < MAX_TRIMS; t++) {
+      if (getTrimValue(p, t) != getTrimValue(first, t))
+        fading.trims |= 1 << t;
+    }
+  }
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed)) break; // end of list
+    if (isFlightModeMaskFading(ed->flightModes, fading) ||
+        isSwitchFading(ed->swtch) || isSourceFading(ed->srcRaw, fading) ||
+        isGVarFieldFading(ed->weight, -100, 100, fading) ||
+        isGVarFieldFading(ed->offset, -100, 100, fading) ||
+        isCurveFading(ed->curve, fading)) {
+      fading.inputs |= (uint32_t)1 << ed->chn;
+    }
+  }
+
+  // source channels come first in the plan
+  const MixPlan & plan = getMixPlan();
+  for (uint8_t k = 0; k < plan.count; k++) {
+    MixData * md = mixAddress(plan.lines[k]);
+    bitfield_channels_t mask = (bitfield_channels_t)1 << md->destCh;
+    if (fading.channels & mask)
+      continue;
+    // delays are only applied in the active flight mode
+    if (isFlightModeMaskFading(md->flightModes, fading) ||
+        isSwitchFading(md->swtch) || md->delayUp || md->delayDown ||
+        isSourceFading(md->srcRaw, fading) ||
+        isGVarFieldFading(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, fading) ||
+        isGVarFieldFading(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, fading) ||
+        isCurveFading(md->curve, fading)) {
+      fading.channels |= mask;
+    }
+    else if (md->carryTrim == 0) {
+      int origin = getSourceTrimOrigin(md->srcRaw);
+      if (origin >= 0 && (fading.trims & (1 << origin)))
+        fading.channels |= mask;
+    }
+  }
+
+  return fading.channels;
+}
+
+static uint16_t fadingChannelsModes = 0;
+static bitfield_channels_t fadingChannels = 0;
+
+// saved state of the active flight mode while the others are evaluated
+static int32_t fadeActiveChans[MAX_OUTPUT_CHANNELS];
+static int16_t fadeActiveAnas[MAX_INPUTS];
+static int16_t fadeActiveTrims[MAX_TRIMS];
 
-#define MAX_ACT 0xffff
 uint8_t lastFlightMode = 255; // TODO reinit everything here when the model changes, no???
 
 tmr10ms_t flightModeTransitionTime;
@@ -1048,23 +1167,52 @@ void evalMixes(uint8_t tick10ms)
   }
 
   int32_t weight = 0;
+  mixerCurrentFlightMode = fm;
+  evalFlightModeMixes(e_perout_mode_normal, tick10ms);
+
   if (flightModesFade) {
+    DEBUG_TIMER_START(debugTimerMixFade);
+    // the other flight modes only re-evaluate the channels which differ
+    // from the active one, the other channels keep the active values
+    uint16_t fadeModes = flightModesFade | (0x01 << fm);
+    // checked again each 10ms, as trims and GVARs may change during the fade
+    if (tick10ms || fadeModes != fadingChannelsModes) {
+      fadingChannelsModes = fadeModes;
+      fadingChannels = (fadeModes != (0x01 << fm) ? getFadingChannels(fadeModes) : 0);
+    }
+    if (fadingChannels) {
+      memcpy(fadeActiveChans, chans, sizeof(chans));
+      memcpy(fadeActiveAnas, anas, sizeof(anas));
+      memcpy(fadeActiveTrims, trims, sizeof(trims));
+    }
+
     memclear(sum_chans512, sizeof(sum_chans512));
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
       if (flightModesFade & (0x01 << p)) {
-        mixerCurrentFlightMode = p;
-        evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+        if (p != fm && fadingChannels) {
+          mixerCurrentFlightMode = p;
+          evalFlightModeMixes(e_perout_mode_inactive_flight_mode, 0, fadingChannels);
+        }
+        else if (p == fm && fadingChannels) {
+          memcpy(chans, fadeActiveChans, sizeof(chans));
+        }
         for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
           sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
         weight += fp_act[p];
       }
     }
     assert(weight);
-    mixerCurrentFlightMode = fm;
+
+    if (fadingChannels) {
+      memcpy(chans, fadeActiveChans, sizeof(chans));
+      memcpy(anas, fadeActiveAnas, sizeof(anas));
+      memcpy(trims, fadeActiveTrims, sizeof(trims));
+      mixerCurrentFlightMode = fm;
+    }
+    DEBUG_TIMER_STOP(debugTimerMixFade);
   }
   else {
-    mixerCurrentFlightMode = fm;
-    evalFlightModeMixes(e_perout_mode_normal, tick10ms);
+    fadingChannelsModes = 0;
   }
 
   //========== FUNCTIONS ===============
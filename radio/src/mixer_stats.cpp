@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string.h>
+
+#include "mixer_stats.h"
+#include "timers_driver.h"
+
+MixerStats mixerStats;
+
+// start of the previous cycle, 0 when unknown
+static uint32_t lastCycleStart = 0;
+
+static const char * const stageNames[MIXER_STAGE_COUNT] = {
+  "adc",
+  "switches",
+  "mixes",
+  "pulses",
+  "periodic",
+};
+
+void mixerStatsReset()
+{
+  memset(&mixerStats, 0, sizeof(mixerStats));
+  lastCycleStart = 0;
+}
+
+uint8_t mixerStatsBucket(uint32_t us)
+{
+  uint8_t bucket = 0;
+  while (us && bucket < MIXER_STATS_BUCKETS - 1) {
+    us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+uint32_t mixerStatsPercentile(const uint32_t * histogram, uint8_t percent)
+{
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < MIXER_STATS_BUCKETS; i++) {
+    total += histogram[i];
+  }
+
+  uint32_t count = 0;
+  for (uint8_t i = 0; i < MIXER_STATS_BUCKETS; i++) {
+    count += histogram[i];
+    if (count && (uint64_t)count * 100 >= (uint64_t)total * percent) {
+      return (uint32_t)1 << i;
+    }
+  }
+  return 0;
+}
+
+void mixerStatsCycleStart(uint32_t now, uint16_t period)
+{
+  if (lastCycleStart) {
+    uint32_t interval = now - lastCycleStart;
+    uint32_t jitter = (interval > period ? interval - period : period - interval);
+    if (jitter > mixerStats.jitterMax) {
+      mixerStats.jitterMax = (jitter > 0xFFFF ? 0xFFFF : jitter);
+    }
+    mixerStats.jitterHistogram[mixerStatsBucket(jitter)]++;
+  }
+  // 0 is reserved for 'unknown'
+  lastCycleStart = (now ? now : 1);
+}
+
+void mixerStatsPause()
+{
+  lastCycleStart = 0;
+}
+
+void mixerStatsCycleEnd(uint32_t duration, uint16_t period)
+{
+  mixerStats.cycles++;
+  if (duration > period) {
+    mixerStats.overruns++;
+  }
+  mixerStats.cycleHistogram[mixerStatsBucket(duration)]++;
+}
+
+uint32_t mixerStatsStage(uint8_t stage, uint32_t start)
+{
+  uint32_t now = timersGetUsTick();
+  uint32_t duration = now - start;
+  if (duration > 0xFFFF) {
+    duration = 0xFFFF;
+  }
+  mixerStats.stageLast[stage] = duration;
+  if (duration > mixerStats.stageMax[stage]) {
+    mixerStats.stageMax[stage] = duration;
+  }
+  return now;
+}
+
+const char * mixerStatsStageName(uint8_t stage)
+{
+  return stage < MIXER_STAGE_COUNT ? stageNames[stage] : "";
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Mixer cycle timings, always collected by the mixer task
+
+enum MixerStage {
+  MIXER_STAGE_ADC,
+  MIXER_STAGE_SWITCHES,
+  MIXER_STAGE_MIXES,
+  MIXER_STAGE_PULSES,
+  MIXER_STAGE_PERIODIC,
+  MIXER_STAGE_COUNT
+};
+
+// bucket 0 counts 0us, bucket n counts [2^(n-1), 2^n[ us,
+// the last one everything above
+#define MIXER_STATS_BUCKETS  16
+
+struct MixerStats {
+  uint32_t cycles;
+  uint32_t overruns;  // cycles longer than the scheduler period
+  uint16_t stageLast[MIXER_STAGE_COUNT];  // us
+  uint16_t stageMax[MIXER_STAGE_COUNT];   // us
+  uint16_t jitterMax;                     // us
+  uint32_t cycleHistogram[MIXER_STATS_BUCKETS];
+  // distance between two cycle starts and the scheduler period
+  uint32_t jitterHistogram[MIXER_STATS_BUCKETS];
+};
+
+extern MixerStats mixerStats;
+
+void mixerStatsReset();
+
+// to be called at the start of each mixer cycle
+void mixerStatsCycleStart(uint32_t now, uint16_t period);
+
+// the next cycle start will not be compared with the previous one
+void mixerStatsPause();
+
+// duration of the whole cycle
+void mixerStatsCycleEnd(uint32_t duration, uint16_t period);
+
+// records the stage duration since start and returns the current time
+uint32_t mixerStatsStage(uint8_t stage, uint32_t start);
+
+uint8_t mixerStatsBucket(uint32_t us);
+
+// upper bound in us of the bucket containing this percentile
+uint32_t mixerStatsPercentile(const uint32_t * histogram, uint8_t percent);
+
+const char * mixerStatsStageName(uint8_t stage);
@@ -157,3 +157,145 @@ void updateMixCount()
 {
   _nb_mix_lines = _countMixLines();
 }
+
+static MixPlan _mix_plan;
+
+static inline uint16_t _mixKey(const MixData* md)
+{
+  return (md->srcRaw << 5) | md->destCh;
+}
+
+static bool _isMixPlanValid()
+{
+  for (uint8_t i = 0; i < _mix_plan.end; i++) {
+    if (_mixKey(mixAddress(i)) != _mix_plan.keys[i]) return false;
+  }
+
+  // a line appended after the last one would not be covered
+  return _mix_plan.end >= MAX_MIXERS ||
+         mixAddress(_mix_plan.end)->srcRaw == 0;
+}
+
+// Pick the next channel to compute: the lowest one with all its
+// source channels computed already or, if channels are waiting on
+// each other, the lowest one only waiting on channels of its own loop
+static uint8_t _nextPlanChannel(const bitfield_channels_t* channelDeps,
+                                const bitfield_channels_t* reach,
+                                bitfield_channels_t doneChannels)
+{
+  for (uint8_t loops = 0; loops < 2; loops++) {
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      bitfield_channels_t mask = (bitfield_channels_t)1 << ch;
+      if (doneChannels & mask) continue;
+
+      bitfield_channels_t pending = channelDeps[ch] & ~doneChannels;
+      if (loops) {
+        for (uint8_t src = 0; src < MAX_OUTPUT_CHANNELS; src++) {
+          if (reach[src] & mask) pending &= ~((bitfield_channels_t)1 << src);
+        }
+      }
+      if (!pending) return ch;
+    }
+  }
+
+  return MAX_OUTPUT_CHANNELS;
+}
+
+static void _buildMixPlan()
+{
+  bitfield_channels_t channelDeps[MAX_OUTPUT_CHANNELS];
+  bitfield_channels_t reach[MAX_OUTPUT_CHANNELS];
+  bitfield_channels_t usedChannels = 0;
+
+  memclear(channelDeps, sizeof(channelDeps));
+  _mix_plan.end = 0;
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData* md = mixAddress(i);
+    _mix_plan.keys[i] = _mixKey(md);
+    swOn[i].activeMix = false;
+
+    if (md->srcRaw == 0)
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+
+    _mix_plan.end = i + 1;
+    resolveSource(_mix_plan.sources[i], md->srcRaw);
+    usedChannels |= (bitfield_channels_t)1 << md->destCh;
+
+    mixsrc_t srcCh = md->srcRaw - MIXSRC_FIRST_CH;
+    if (srcCh <= MIXSRC_LAST_CH - MIXSRC_FIRST_CH && srcCh != md->destCh) {
+      channelDeps[md->destCh] |= (bitfield_channels_t)1 << srcCh;
+    }
+  }
+
+  // channels without any line are always 0: no need to wait for them
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    channelDeps[ch] &= usedChannels;
+  }
+
+  // Transitive closure of the dependency graph: a channel
+  // reaching itself is part of a loop
+  memcpy(reach, channelDeps, sizeof(reach));
+  bool changed;
+  do {
+    changed = false;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      bitfield_channels_t r = reach[ch];
+      for (uint8_t src = 0; src < MAX_OUTPUT_CHANNELS; src++) {
+        if (reach[ch] & ((bitfield_channels_t)1 << src)) r |= reach[src];
+      }
+      if (r != reach[ch]) {
+        reach[ch] = r;
+        changed = true;
+      }
+    }
+  } while (changed);
+
+  _mix_plan.loopChannels = 0;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    if (reach[ch] & ((bitfield_channels_t)1 << ch))
+      _mix_plan.loopChannels |= (bitfield_channels_t)1 << ch;
+  }
+
+  // Topological sort of the channels, lines kept in their order
+  // inside each channel
+  bitfield_channels_t doneChannels = ~usedChannels;
+  uint8_t count = 0;
+
+  _mix_plan.currentChannelSources = 0;
+  while (doneChannels != (bitfield_channels_t)-1) {
+    uint8_t ch = _nextPlanChannel(channelDeps, reach, doneChannels);
+    if (ch >= MAX_OUTPUT_CHANNELS) break;  // should not happen
+
+    for (uint8_t i = 0; i < _mix_plan.end; i++) {
+      MixData* md = mixAddress(i);
+      if (!md->srcRaw || md->destCh != ch) continue;
+
+      _mix_plan.lines[count++] = i;
+
+      mixsrc_t srcCh = md->srcRaw - MIXSRC_FIRST_CH;
+      if (srcCh <= MIXSRC_LAST_CH - MIXSRC_FIRST_CH && srcCh != ch &&
+          (doneChannels & ((bitfield_channels_t)1 << srcCh))) {
+        _mix_plan.currentChannelSources |= (uint64_t)1 << i;
+      }
+    }
+    doneChannels |= (bitfield_channels_t)1 << ch;
+  }
+
+  _mix_plan.count = count;
+}
+
+const MixPlan& getMixPlan()
+{
+  if (!_isMixPlanValid()) _buildMixPlan();
+  return _mix_plan;
+}
+
+bool isMixChannelInLoop(uint8_t ch)
+{
+  return _mix_plan.loopChannels & ((bitfield_channels_t)1 << ch);
+}
@@ -22,9 +22,26 @@
 #pragma once
 
 #include <stdint.h>
+#include "dataconstants.h"
+#include "sources.h"
 
 struct MixData;
 
+// Compiled mixer execution plan: the active mixer lines grouped
+// by destination channel, with channels sorted so that a channel
+// is always computed before the channels using it as a source.
+// Inside a loop of channels, a source channel not computed yet
+// gives its value from the previous mixer cycle.
+struct MixPlan {
+  uint8_t lines[MAX_MIXERS];  // mixer line indexes in evaluation order
+  uint8_t count;              // number of active lines
+  uint8_t end;                // number of slots covered by the plan
+  bitfield_channels_t loopChannels;  // channels depending on themselves through other channels
+  uint64_t currentChannelSources;    // lines using a channel computed earlier in the same pass
+  uint16_t keys[MAX_MIXERS];  // source / channel of each covered slot
+  SourceRef sources[MAX_MIXERS];  // resolved source of each active line
+};
+
 // Get a pointer to a mixer line
 MixData* mixAddress(uint8_t idx);
 
@@ -43,6 +60,15 @@ uint8_t moveMix(uint8_t idx, bool up);
 
 uint8_t getMixCount();
 
+// Get the mixer plan, rebuilt first if some mixer lines
+// were added, removed, moved or had their source or
+// destination channel changed since it was last built
+const MixPlan& getMixPlan();
+
+// Whether a channel is part of a loop of channels using each
+// other as source (as of the last mixer run)
+bool isMixChannelInLoop(uint8_t ch);
+
 // Should only be called from storage
 // right after a model has been loaded
 void updateMixCount();
@@ -1106,6 +1106,7 @@ void opentxClose(uint8_t shutdown)
 
 #if defined(SDCARD)
   logsClose();
+  logsHighRateStop();
 #endif
 
   storageFlushCurrentModel();
@@ -300,10 +300,21 @@ void memswap(void * a, void * b, uint8_t size);
 #define MASK_CFN_TYPE  uint64_t  // current max = 64 customizable switches
 #define MASK_FUNC_TYPE uint32_t  // current max = 32 functions
 
+// Compiled special functions table: the populated functions only,
+// in their order, each one pointing to the first function sharing
+// its trigger so that a switch is only read once per pass
+struct CustomFunctionsPlan {
+  uint16_t keys[MAX_SPECIAL_FUNCTIONS];  // switch / function of each slot
+  uint8_t functions[MAX_SPECIAL_FUNCTIONS];  // populated slots
+  uint8_t triggers[MAX_SPECIAL_FUNCTIONS];   // plan position of the trigger
+  uint8_t count;
+};
+
 struct CustomFunctionsContext {
   MASK_FUNC_TYPE activeFunctions;
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
+  CustomFunctionsPlan plan;
 
   inline bool isFunctionActive(uint8_t func)
   {
@@ -437,7 +448,8 @@ extern uint8_t flightModeTransitionLast;
 extern uint32_t availableMemory();
 
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
+#define MIX_ALL_CHANNELS ((bitfield_channels_t)-1)
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t channels = MIX_ALL_CHANNELS);
 void evalMixes(uint8_t tick10ms);
 void doMixerCalculations();
 void doMixerPeriodicUpdates();
@@ -109,7 +109,7 @@ static void crossfireSetupMixerScheduler(uint8_t module)
   }
 }
 
-static bool _checkFrameCRC(uint8_t* rxBuffer)
+static bool _checkFrameCRC(const uint8_t* rxBuffer)
 {
   uint8_t len = rxBuffer[1];
   uint8_t crc = crc8(&rxBuffer[2], len-1);
@@ -169,6 +169,18 @@ static void _seekStart(uint8_t* buffer, uint8_t* len)
   *len = 0;
 }
 
+static void _processFrame(void* ctx, const uint8_t* frame, uint8_t len)
+{
+#if defined(BLUETOOTH) // TODO: generic telemetry mirror to BT
+  if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
+      bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
+    bluetooth.write(frame, len);
+  }
+#endif
+  auto mod_st = (etx_module_state_t*)ctx;
+  processCrossfireTelemetryFrame(modulePortGetModule(mod_st), frame, len);
+}
+
 static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
 {
   if (*len == 0 && data != RADIO_ADDRESS && data != UART_SYNC) {
@@ -193,14 +205,7 @@ static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8
   // rxBuffer[1] holds the packet length-2, check if the whole packet was received
   while (*len > 4 && (buffer[1]+2) == *len) {
     if (_checkFrameCRC(buffer)) {
-#if defined(BLUETOOTH) // TODO: generic telemetry mirror to BT
-      if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
-          bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
-        bluetooth.write(buffer, *len);
-      }
-#endif
-      auto mod_st = (etx_module_state_t*)ctx;
-      processCrossfireTelemetryFrame(modulePortGetModule(mod_st));
+      _processFrame(ctx, buffer, *len);
       *len = 0;
     }
     else {
@@ -210,6 +215,59 @@ static void crossfireProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8
   }
 }
 
+static void crossfireProcessBlock(void* ctx, const uint8_t* data,
+                                  uint32_t data_len, uint8_t* buffer,
+                                  uint8_t* len)
+{
+  // complete the frame started in a previous block
+  while (data_len > 0 && *len > 0) {
+    crossfireProcessData(ctx, *data++, buffer, len);
+    data_len--;
+  }
+
+  // whole frames are parsed in place, without going through the buffer
+  while (data_len > 1) {
+    if (data[0] != RADIO_ADDRESS && data[0] != UART_SYNC) {
+      data++;
+      data_len--;
+      continue;
+    }
+
+    if (!_lenIsSane(data[1])) {
+      TRACE("[XF] length 0x%02X error", data[1]);
+      data += 2;
+      data_len -= 2;
+      continue;
+    }
+
+    uint32_t frame_len = data[1] + 2;
+    if (frame_len > data_len) break;
+
+    uint32_t skip = frame_len;
+    if (_checkFrameCRC(data)) {
+      _processFrame(ctx, data, frame_len);
+    } else {
+      TRACE("[XF] CRC error ");
+      // same resync as _seekStart()
+      for (uint32_t idx = 1; idx < frame_len; idx++) {
+        if ((data[idx] == RADIO_ADDRESS || data[idx] == UART_SYNC) &&
+            (idx + 1 == frame_len || _lenIsSane(data[idx + 1]))) {
+          skip = idx;
+          break;
+        }
+      }
+    }
+    data += skip;
+    data_len -= skip;
+  }
+
+  // keep the start of the next frame
+  while (data_len > 0) {
+    crossfireProcessData(ctx, *data++, buffer, len);
+    data_len--;
+  }
+}
+
 static const etx_serial_init crsfSerialParams = {
   .baudrate = 0,
   .encoding = ETX_Encoding_8N1,
@@ -257,4 +315,5 @@ const etx_proto_driver_t CrossfireDriver = {
   .deinit = crossfireDeInit,
   .sendPulses = crossfireSendPulses,
   .processData = crossfireProcessData,
+  .processBlock = crossfireProcessBlock,
 };
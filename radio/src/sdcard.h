@@ -83,6 +83,8 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 
 #define MODELS_EXT          ".bin"
 #define LOGS_EXT            ".csv"
+#define LOGS_BINARY_EXT     ".bin"
+#define LOGS_HIGH_RATE_EXT  "-hr" LOGS_BINARY_EXT
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
@@ -120,9 +122,22 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
   strcat(&filename[sizeof(path)], ext)
 
 extern uint8_t logDelay100ms;
+extern uint32_t logsDroppedRows;
 void logsInit();
 void logsClose();
 void logsWrite();
+void logsFlush();
+
+// high rate logs, sampled on the mixer cycle
+#define LOGS_HIGH_RATE_MAX_SOURCES  16
+#define LOGS_HIGH_RATE_MAX_RATE     250  // Hz, one row per mixer cycle at most
+extern uint32_t logsHighRateRows;
+extern uint32_t logsHighRateDroppedRows;
+bool logsHighRateStart(const mixsrc_t * sources, uint8_t count, uint16_t rate);
+void logsHighRateStop();
+bool logsHighRateActive();
+void logsHighRateSample();
+void logsHighRateFlush();
 
 void sdInit();
 void sdMount();
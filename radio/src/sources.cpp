@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "input_mapping.h"
+#include "sources.h"
+
+#include "hal/adc_driver.h"
+
+#if defined(HELI)
+extern int16_t cyc_anas[3];
+#endif
+
+static void setAdcInput(SourceRef& ref, uint8_t type, mixsrc_t idx)
+{
+  if (idx < adcGetMaxInputs(type)) {
+    ref.kind = SOURCE_KIND_INT16;
+    ref.ptr = &calibratedAnalogs[idx + adcGetInputOffset(type)];
+  }
+}
+
+void resolveSource(SourceRef& ref, mixsrc_t src)
+{
+  ref.src = src;
+  ref.kind = SOURCE_KIND_NONE;
+  ref.ptr = nullptr;
+
+  if (src == MIXSRC_NONE) {
+    return;
+  }
+  else if (src <= MIXSRC_LAST_INPUT) {
+    ref.kind = SOURCE_KIND_INT16;
+    ref.ptr = &anas[src - MIXSRC_FIRST_INPUT];
+  }
+#if defined(LUA_INPUTS)
+  else if (src <= MIXSRC_LAST_LUA) {
+#if defined(LUA_MODEL_SCRIPTS)
+    div_t qr = div(src - MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
+    ref.kind = SOURCE_KIND_INT16;
+    ref.ptr = &scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
+#endif
+  }
+#endif
+  else if (src <= MIXSRC_LAST_STICK) {
+    src -= MIXSRC_FIRST_STICK;
+    if (src < adcGetMaxInputs(ADC_INPUT_MAIN)) {
+      ref.kind = SOURCE_KIND_STICK;
+      ref.value = src;
+    }
+  }
+  else if (src <= MIXSRC_LAST_POT) {
+    setAdcInput(ref, ADC_INPUT_POT, src - MIXSRC_FIRST_POT);
+  }
+#if MAX_AXIS > 0
+  else if (src <= MIXSRC_LAST_AXIS) {
+    setAdcInput(ref, ADC_INPUT_AXIS, src - MIXSRC_FIRST_AXIS);
+  }
+#endif
+  else if (src == MIXSRC_MIN || src == MIXSRC_MAX) {
+    ref.kind = SOURCE_KIND_CONST;
+    ref.value = (src == MIXSRC_MIN ? -RESX : RESX);
+  }
+#if defined(HELI)
+  else if (src >= MIXSRC_FIRST_HELI && src <= MIXSRC_LAST_HELI) {
+    ref.kind = SOURCE_KIND_INT16;
+    ref.ptr = &cyc_anas[src - MIXSRC_FIRST_HELI];
+  }
+#endif
+  else if (src >= MIXSRC_FIRST_CH && src <= MIXSRC_LAST_CH) {
+    ref.kind = SOURCE_KIND_INT16;
+    ref.ptr = &ex_chans[src - MIXSRC_FIRST_CH];
+  }
+  else if (src == MIXSRC_TX_VOLTAGE) {
+    ref.kind = SOURCE_KIND_UINT8;
+    ref.ptr = &g_vbat100mV;
+  }
+  else if (src >= MIXSRC_FIRST_TIMER && src <= MIXSRC_LAST_TIMER) {
+    ref.kind = SOURCE_KIND_INT32;
+    ref.ptr = &timersStates[src - MIXSRC_FIRST_TIMER].val;
+  }
+  else if (src >= MIXSRC_FIRST_TELEM && src <= MIXSRC_LAST_TELEM) {
+    div_t qr = div(src - MIXSRC_FIRST_TELEM, 3);
+    TelemetryItem & telemetryItem = telemetryItems[qr.quot];
+    ref.kind = SOURCE_KIND_TELEM;
+    switch (qr.rem) {
+      case 1:
+        ref.ptr = &telemetryItem.valueMin;
+        break;
+      case 2:
+        ref.ptr = &telemetryItem.valueMax;
+        break;
+      default:
+        ref.ptr = &telemetryItem.value;
+        break;
+    }
+  }
+  else if (src <= MIXSRC_LAST_TELEM) {
+    // trims, switches, trainer, GVARs, ... depend on the
+    // current flight mode or on the radio configuration
+    ref.kind = SOURCE_KIND_GENERIC;
+  }
+}
+
+getvalue_t getValue(const SourceRef& ref)
+{
+  switch (ref.kind) {
+    case SOURCE_KIND_CONST:
+      return ref.value;
+    case SOURCE_KIND_INT16:
+      return *(const int16_t *)ref.ptr;
+    case SOURCE_KIND_INT32:
+      return *(const int32_t *)ref.ptr;
+    case SOURCE_KIND_UINT8:
+      return *(const uint8_t *)ref.ptr;
+    case SOURCE_KIND_STICK:
+      return calibratedAnalogs[inputMappingConvertMode(ref.value)];
+    case SOURCE_KIND_TELEM:
+      if (IS_FAI_FORBIDDEN(ref.src)) return 0;
+      return *(const int32_t *)ref.ptr;
+    case SOURCE_KIND_GENERIC:
+      return getValue(ref.src);
+    default:
+      return 0;
+  }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "opentx_types.h"
+
+enum SourceKind : uint8_t {
+  SOURCE_KIND_NONE,     // invalid source, value is 0
+  SOURCE_KIND_CONST,    // constant value
+  SOURCE_KIND_INT16,    // int16_t variable
+  SOURCE_KIND_INT32,    // int32_t variable
+  SOURCE_KIND_UINT8,    // uint8_t variable
+  SOURCE_KIND_STICK,    // stick, depends on the stick mode
+  SOURCE_KIND_TELEM,    // telemetry value, may be forbidden in FAI mode
+  SOURCE_KIND_GENERIC,  // evaluated with getValue()
+};
+
+// Mixer source pre-resolved into a direct access to its value
+struct SourceRef {
+  union {
+    const void* ptr;
+    int32_t value;
+  };
+  uint16_t src;
+  SourceKind kind;
+};
+
+// Resolve 'src' into 'ref'
+void resolveSource(SourceRef& ref, mixsrc_t src);
+
+// Same as getValue(ref.src), without going through all source ranges
+getvalue_t getValue(const SourceRef& ref);
+
+// Get the value of 'src', resolving it into 'ref' first
+// if 'ref' was resolved for another source
+inline getvalue_t getValue(SourceRef& ref, mixsrc_t src)
+{
+  if (ref.src != src) resolveSource(ref, src);
+  return getValue(ref);
+}
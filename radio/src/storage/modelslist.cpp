@@ -621,6 +621,9 @@ bool ModelMap::renameLabel(const std::string &from, std::string to,
   if (from == "") return true;
   DEBUG_TIMER_START(debugTimerYamlScan);
 
+  // labels of all the models are needed
+  modelslist.updateAllModels();
+
   if(to.size() > 0) { // Ignore check if deleting a label, size will be zero
     to = to.substr(0, LABEL_LENGTH); // Limit max label name. TODO: Warn user they entered too long of a string
     removeYAMLChars(to); // Remove special chars
@@ -878,6 +881,10 @@ void ModelsList::init()
 {
   loaded = false;
   currentModel = nullptr;
+  pendingModels.clear();
+  pendingIndex = 0;
+  pendingSave = false;
+  updateCount = 0;
 }
 
 void ModelsList::clear()
@@ -979,6 +986,27 @@ char *FILInfoToHexStr(char buffer[17], FILINFO *finfo)
   return buffer;
 }
 
+/**
+ * @brief Indexes the files found in /MODELS by name, so that models.yml
+ *        and labels.yml entries are matched without scanning the list
+ */
+
+void ModelsList::indexFileHashes()
+{
+  fileHashIndex.clear();
+  fileHashIndex.reserve(fileHashInfo.size());
+  for (unsigned int i = 0; i < fileHashInfo.size(); i++) {
+    fileHashIndex.emplace(fileHashInfo[i].name, i);
+  }
+}
+
+ModelsList::filedat *ModelsList::findFileHash(const char *name)
+{
+  auto it = fileHashIndex.find(name);
+  if (it == fileHashIndex.end()) return nullptr;
+  return &fileHashInfo[it->second];
+}
+
 /**
  * @brief Loads the Labels and Models from the labels.yml file
  *
@@ -992,6 +1020,7 @@ bool ModelsList::loadYaml()
   modelslist.clear();
   modelslabels.clear();
   fileHashInfo.clear();
+  fileHashIndex.clear();
 
   DEBUG_TIMER_START(debugTimerYamlScan);
 
@@ -1040,6 +1069,7 @@ bool ModelsList::loadYaml()
     }
     f_closedir(&moddir);
   }
+  indexFileHashes();
 
   // Check if models.yml exists
   // Any files found above that are not listed in the file will be moved into
@@ -1082,17 +1112,10 @@ bool ModelsList::loadYaml()
     f_close(&file);
 
     // Loop through file hases, move any files found that don't exists to /unused
+    std::unordered_set<std::string> listedFiles(modfiles.begin(), modfiles.end());
     std::vector<filedat> newFileHash;
     for(const auto &fhas: fileHashInfo) {
-      bool found = false;
-      for(const auto &file : modfiles) {
-        if (file == fhas.name) {
-          TRACE_LABELS("Found file %s in models.yml.. OK!", file);
-          found = true;
-          break;
-        }
-      }
-      if(!found) {
+      if(listedFiles.find(fhas.name) == listedFiles.end()) {
         moveRequired = true;
         TRACE_LABELS("Model %s not in models.yml, moving to /UNUSED", fhas.name.c_str());
         // Move model into unused folder.
@@ -1100,6 +1123,7 @@ bool ModelsList::loadYaml()
         if(warning)
           POPUP_WARNING(warning);
       } else {
+        TRACE_LABELS("Found file %s in models.yml.. OK!", fhas.name.c_str());
         newFileHash.push_back(fhas); // File exists, keep it
       }
     }
@@ -1116,6 +1140,7 @@ bool ModelsList::loadYaml()
     }
     if(moveRequired) {
       fileHashInfo = newFileHash; // Update the new file list
+      indexFileHashes();
       POPUP_WARNING(TR_MODELS_MOVED "\n" UNUSED_MODELS_PATH, "\n" TR_PRESS_ANY_KEY_TO_SKIP);
     }
   }
@@ -1164,25 +1189,24 @@ bool ModelsList::loadYaml()
     }
   }
 
-  // Scan all models, to see if update needed
-  bool updatelabelsyml = false;
+  // Models which need to be read are only listed here: the current one is
+  // read right away, the others by updateNextModel() in the background
   for (auto &model : modelslist) {
-    // Open and read each model if it's marked as dirty
     if (model->_isDirty) {
-      updatelabelsyml = true;
-      modelslabels.updateModelCell(model);
+      if (model == currentModel)
+        modelslabels.updateModelCell(model);
+      else {
+        model->_isPending = true;
+        pendingModels.push_back(model);
+      }
+      pendingSave = true;
     }
   }
 
   fileHashInfo.clear();
+  fileHashIndex.clear();
 
-  // If any items differed save the file
-  if (updatelabelsyml == true) {
-    TRACE_LABELS("LABELS.YML Wasn't in sync. Needs to be saved");
-    modelslist.save();
-  } else {
-    TRACE_LABELS("LABELS.YML Is in Sync! No models were read");
-  }
+  if (!isUpdating()) updateDone();
 
   // If no labels found. Add a favorites label
   if (modelslabels.getLabels().size() == 0) {
@@ -1191,6 +1215,53 @@ bool ModelsList::loadYaml()
 
   return true;
 }
+
+/**
+ * @brief Reads the next model whose file changed since labels.yml was
+ *        written, called periodically once the list is loaded
+ *
+ * @return true if some models are still pending
+ * @return false once all the models are read
+ */
+
+bool ModelsList::updateNextModel()
+{
+  if (!isUpdating()) return false;
+
+  ModelCell *cell = pendingModels[pendingIndex++];
+  if (cell) {
+    cell->_isPending = false;
+    modelslabels.updateModelCell(cell);
+    updateCount++;
+  }
+
+  if (isUpdating()) return true;
+
+  updateDone();
+  return false;
+}
+
+void ModelsList::updateAllModels()
+{
+  while (updateNextModel()) {
+  }
+}
+
+void ModelsList::updateDone()
+{
+  pendingModels.clear();
+  pendingIndex = 0;
+
+  // If any items differed save the file
+  if (pendingSave) {
+    pendingSave = false;
+    TRACE_LABELS("LABELS.YML Wasn't in sync. Needs to be saved");
+    save();
+  } else {
+    TRACE_LABELS("LABELS.YML Is in Sync! No models were read");
+  }
+}
+
 #endif
 
 /**
@@ -1282,8 +1353,9 @@ const char *ModelsList::save(LabelsVector newOrder)
     f_puts(model->modelFilename, &file);
     f_puts(":\r\n", &file);
 
+    // models not read yet are read again on next load
     f_puts("    hash: \"", &file);
-    f_puts(model->modelFinfoHash, &file);
+    if (!isPending(model)) f_puts(model->modelFinfoHash, &file);
     f_puts("\"\r\n", &file);
 
     f_puts("    name: \"", &file);
@@ -1430,6 +1502,8 @@ ModelCell *ModelsList::addModel(const char *fileName, bool save, ModelCell *copy
 bool ModelsList::removeModel(ModelCell *model)
 {
   erase(std::remove(begin(), end(), model), end());
+  std::replace(pendingModels.begin(), pendingModels.end(), model,
+               (ModelCell *)nullptr);
   modelslabels.removeModels(model);
 
   // Create deleted folder if it doesn't exist
@@ -1496,6 +1570,9 @@ bool ModelsList::moveModelTo(unsigned curindex, unsigned toindex)
 bool ModelsList::isModelIdUnique(uint8_t moduleIdx, char *warn_buf,
                                  size_t warn_buf_len)
 {
+  // needs the RF data of all the models
+  updateAllModels();
+
   ModelCell *modelCell = modelslist.getCurrentModel();
   if (!modelCell || !modelCell->valid_rfData) {
     // in doubt, pretend it's unique
@@ -1561,6 +1638,9 @@ bool ModelsList::isModelIdUnique(uint8_t moduleIdx, char *warn_buf,
 
 uint8_t ModelsList::findNextUnusedModelId(uint8_t moduleIdx)
 {
+  // needs the RF data of all the models
+  updateAllModels();
+
   ModelCell *modelCell = modelslist.getCurrentModel();
   if (!modelCell || !modelCell->valid_rfData) {
     return 0;
@@ -31,6 +31,8 @@
 #include <set>
 #include <string>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "sdcard.h"
@@ -81,6 +83,7 @@ class ModelCell
 #endif
   gtime_t lastOpened = 0;
   bool _isDirty = true;
+  bool _isPending = false;  // queued in ModelsList::pendingModels
 
   bool valid_rfData;
   uint8_t modelId[NUM_MODULES] = {0, 0};
@@ -218,7 +221,15 @@ class ModelsList : public ModelsVector
 
   ModelCell *currentModel;
 
+  // Models whose file changed since labels.yml was written, read in the
+  // background by updateNextModel()
+  ModelsVector pendingModels;
+  unsigned int pendingIndex;
+  bool pendingSave;
+  uint32_t updateCount;
+
   void init();
+  void updateDone();
 
  public:
   enum class Format {
@@ -251,6 +262,15 @@ class ModelsList : public ModelsVector
 
   bool readNextLine(char *line, int maxlen);
 
+  // Reads the next pending model, returns false once they are all read
+  bool updateNextModel();
+  void updateAllModels();
+  bool isPending(ModelCell *cell) const { return cell->_isPending; }
+  bool isUpdating() const { return pendingIndex < pendingModels.size(); }
+
+  // Incremented each time a model cell is updated in the background
+  uint32_t getUpdateCount() const { return updateCount; }
+
   ModelCell *addModel(const char *name, bool save = true, ModelCell *copyCell = nullptr);
   bool removeModel(ModelCell *model);
   bool moveModelTo(unsigned curindex, unsigned toindex);
@@ -266,7 +286,14 @@ class ModelsList : public ModelsVector
   } filedat;
   std::vector<filedat> fileHashInfo;
 
+  // Files found in /MODELS by name, nullptr if not found
+  filedat *findFileHash(const char *name);
+
  protected:
+  std::unordered_map<std::string, uint16_t> fileHashIndex;
+
+  void indexFileHashes();
+
   FIL file;
 
   bool loadTxt();
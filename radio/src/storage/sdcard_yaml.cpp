@@ -38,6 +38,14 @@
  #include "storage/eeprom_rlc.h"
 #endif
 
+// The parser and its read buffer are shared by all the YAML reads, as they
+// are too large for the tasks stacks. Reads are sector sized, so that FatFs
+// copies whole sectors straight into the buffer.
+#define YAML_READ_BUFFER_SIZE  512
+
+static YamlParser yamlParser;
+static char yamlReadBuffer[YAML_READ_BUFFER_SIZE + 1];  // zero terminated
+
 const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx, ChecksumResult* checksum_result)
 {
     FIL  file;
@@ -49,18 +57,19 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
         return SDCARD_ERROR(result);
     }
 
-    YamlParser yp; //TODO: move to re-usable buffer
+    YamlParser& yp = yamlParser;
     yp.init(calls, parser_ctx);
 
     uint16_t calculated_checksum = 0xFFFF;
     uint16_t file_checksum = 0;
 
     bool first_block = true;
-    char buffer[32];
-    while (f_read(&file, buffer, sizeof(buffer)-1, &bytes_read) == FR_OK) {
+    char* buffer = yamlReadBuffer;
+    while (f_read(&file, buffer, YAML_READ_BUFFER_SIZE, &bytes_read) == FR_OK) {
       if (bytes_read == 0)  // EOF
         break;
       total_bytes += bytes_read;
+      buffer[bytes_read] = '\0';
 
       uint16_t skip = 0;
       if(first_block) {
@@ -74,7 +83,8 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
           char* endPos = startPos;
           // Advance through the value
           while((*endPos != '\r') && (*endPos != '\n')) {
-            if (endPos > buffer + bytes_read) {
+            if (*endPos == '\0') {
+              f_close(&file);
               return SDCARD_ERROR(	FR_INT_ERR );
             }
             endPos++;
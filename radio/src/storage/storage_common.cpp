@@ -48,6 +48,10 @@ void storageDirty(uint8_t msk)
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  if (msk & EE_MODEL) {
+    telemetrySensorsChanged();
+  }
+
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
@@ -60,6 +64,7 @@ void preModelLoad()
 
 #if defined(SDCARD)
   logsClose();
+  logsHighRateStop();
 #endif
 
   bool needDelay = false;
@@ -229,6 +234,7 @@ if(g_model.rssiSource) {
 
   restoreTimers();
 
+  telemetrySensorsChanged();
   for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
     TelemetrySensor & sensor = g_model.telemetrySensors[i];
     if (sensor.type == TELEM_TYPE_CALCULATED && sensor.persistent) {
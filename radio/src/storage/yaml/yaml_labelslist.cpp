@@ -127,28 +127,23 @@ static bool find_node(void* ctx, char* buf, uint8_t len)
 
     // Model List
     if(mi->level == 1 && mi->section == labelslist_iter::SEC_Models)  {
-      bool found=false;
-      for(auto &filehash : modelslist.fileHashInfo) {
-        if(filehash.name == mi->current_attr) {
-          TRACE_LABELS_YAML("  Model %s has a real file, creating a modelcell", mi->current_attr);
-          if(filehash.celladded) {
-            TRACE_LABELS_YAML("    Duplicate found labels.yml model cell %s already added", mi->current_attr);
-            break;
-          }
-          ModelCell *model = new ModelCell(mi->current_attr);
-          strcpy(model->modelFinfoHash, filehash.hash);
-          modelslist.push_back(model);
-          filehash.celladded = true;
-          if(filehash.curmodel == true)
-            modelslist.setCurrentModel(model);
-          mi->curmodel = model;
-          mi->modeldatavalid = false;
-          mi->curmodel->_isDirty = true;
-          found = true;
-          break;
-        }
+      ModelsList::filedat *filehash = modelslist.findFileHash(mi->current_attr);
+      if(filehash && filehash->celladded) {
+        TRACE_LABELS_YAML("    Duplicate found labels.yml model cell %s already added", mi->current_attr);
+        filehash = nullptr;
       }
-      if(!found) {
+      if(filehash) {
+        TRACE_LABELS_YAML("  Model %s has a real file, creating a modelcell", mi->current_attr);
+        ModelCell *model = new ModelCell(mi->current_attr);
+        strcpy(model->modelFinfoHash, filehash->hash);
+        modelslist.push_back(model);
+        filehash->celladded = true;
+        if(filehash->curmodel == true)
+          modelslist.setCurrentModel(model);
+        mi->curmodel = model;
+        mi->modeldatavalid = false;
+        mi->curmodel->_isDirty = true;
+      } else {
         mi->curmodel = NULL;
         TRACE_LABELS_YAML("File does not exist in /MODELS");
       }
@@ -253,19 +253,9 @@ void YamlTreeWalker::rewind()
 // the current collection (node of type YDT_NONE) is reached.
 //
 // return true if a match has been found.
-bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
+bool YamlTreeWalker::findNextAttr(const char* tag, uint8_t tag_len)
 {
-    if (virt_level)
-        return false;
-
-    rewind();
-
     const struct YamlNode* attr = getAttr();
-    if (isArrayElmt() && attr && attr->type == YDT_IDX) {
-        setAttrValue((char*)tag, tag_len);
-        return true;
-    }
-
     while(attr && attr->type != YDT_NONE) {
 
         if ((tag_len == attr->tag_len())
@@ -280,6 +270,45 @@ bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
     return false;
 }
 
+bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
+{
+    if (virt_level)
+        return false;
+
+    const struct YamlNode* node = getNode();
+    if (isArrayElmt()
+        && (node->type == YDT_ARRAY || node->type == YDT_UNION)
+        && node->u._array.child[0].type == YDT_IDX) {
+        rewind();
+        setAttrValue((char*)tag, tag_len);
+        return true;
+    }
+
+    // Attributes are written in node order: resume from the
+    // current one, which avoids walking the whole node list
+    // for every tag. The cursor state (including the levels
+    // of anonymous unions left on the way) is saved to start
+    // over from the first attribute if the tag is not found.
+    uint8_t saved_level = stack_level;
+    uint8_t saved_anon_union = anon_union;
+    uint8_t saved_levels = anon_union + 1;
+    if (stack_level + saved_levels > NODE_STACK_DEPTH)
+        saved_levels = NODE_STACK_DEPTH - stack_level;
+
+    State saved[NODE_STACK_DEPTH];
+    memcpy(saved, &stack[stack_level], sizeof(State) * saved_levels);
+
+    if (findNextAttr(tag, tag_len))
+        return true;
+
+    stack_level = saved_level;
+    anon_union = saved_anon_union;
+    memcpy(&stack[stack_level], saved, sizeof(State) * saved_levels);
+
+    rewind();
+    return findNextAttr(tag, tag_len);
+}
+
 // Get the current bit offset
 unsigned int YamlTreeWalker::getBitOffset()
 {
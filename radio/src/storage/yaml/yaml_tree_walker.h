@@ -111,6 +111,10 @@ class YamlTreeWalker
     // (and reset the bit offset)
     void rewind();
 
+    // Look for 'tag' from the current attribute to the end
+    // of the current collection.
+    bool findNextAttr(const char* tag, uint8_t tag_len);
+
 public:
     YamlTreeWalker();
 
@@ -139,8 +143,9 @@ public:
         return stack[stack_level + lvl].elmts;
     }
 
-    // Increment the cursor until a match is found or the end of
-    // the current collection (node of type YDT_NONE) is reached.
+    // Move the cursor to the attribute matching 'tag'. The search
+    // starts at the current attribute and wraps around to the first
+    // one of the current collection.
     //
     // return true if a match has been found.
     bool findNode(const char* tag, uint8_t tag_len);
@@ -24,6 +24,7 @@
 
 #include "opentx.h"
 #include "switches.h"
+#include "sources.h"
 #include "input_mapping.h"
 
 #include "tasks/mixer_task.h"
@@ -345,9 +346,12 @@ void getSwitchesPosition(bool startup)
   }
 }
 
-getvalue_t getValueForLogicalSwitch(mixsrc_t i)
+// v1 / v2 sources of each logical switch, resolved on first use
+static SourceRef lsSources[MAX_LOGICAL_SWITCHES][2];
+
+getvalue_t getValueForLogicalSwitch(SourceRef& ref, mixsrc_t i)
 {
-  getvalue_t result = getValue(i);
+  getvalue_t result = getValue(ref, i);
   if (i>=MIXSRC_FIRST_INPUT && i<=MIXSRC_LAST_INPUT) {
     int8_t trimIdx = virtualInputsTrims[i-MIXSRC_FIRST_INPUT];
     if (trimIdx >= 0) {
@@ -411,10 +415,10 @@ bool getLogicalSwitch(uint8_t idx)
     result = (LS_LAST_VALUE(mixerCurrentFlightMode, idx) & (1<<0));
   }
   else {
-    getvalue_t x = getValueForLogicalSwitch(ls->v1);
+    getvalue_t x = getValueForLogicalSwitch(lsSources[idx][0], ls->v1);
     getvalue_t y;
     if (s == LS_FAMILY_COMP) {
-      y = getValueForLogicalSwitch(ls->v2);
+      y = getValueForLogicalSwitch(lsSources[idx][1], ls->v2);
 
       switch (ls->func) {
         case LS_FUNC_EQUAL:
@@ -635,12 +639,161 @@ uint8_t getXPotPosition(uint8_t idx)
 }
 
 
+// Logical switches evaluation plan: the configured switches only, sorted
+// so that a switch is evaluated after the logical switches it uses as
+// v1 / v2 / AND switch. Inside a loop of switches, a switch not evaluated
+// yet gives its state from the previous pass.
+static struct {
+  uint8_t order[MAX_LOGICAL_SWITCHES];  // switch indexes in evaluation order
+  uint8_t count;                        // number of configured switches
+  bool valid;
+  uint64_t keys[MAX_LOGICAL_SWITCHES];  // function / sources of each slot
+} lsPlan;
+
+static inline uint64_t _lsKey(const LogicalSwitchData * ls)
+{
+  return ((uint64_t)(uint16_t)ls->v2 << 32) |
+         ((uint32_t)(ls->andsw & 0x3FF) << 18) |
+         ((uint32_t)(ls->v1 & 0x3FF) << 8) | ls->func;
+}
+
+static bool _isLsPlanValid()
+{
+  if (!lsPlan.valid) return false;
+
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (_lsKey(lswAddress(i)) != lsPlan.keys[i]) return false;
+  }
+  return true;
+}
+
+static uint64_t _lsSwitchDep(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  if (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH)
+    return (uint64_t)1 << (swtch - SWSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+static uint64_t _lsSourceDep(mixsrc_t src)
+{
+  if (src >= MIXSRC_FIRST_LOGICAL_SWITCH && src <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return (uint64_t)1 << (src - MIXSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+static void _buildLsPlan()
+{
+  uint64_t deps[MAX_LOGICAL_SWITCHES];
+  uint64_t reach[MAX_LOGICAL_SWITCHES];
+  uint64_t used = 0;
+
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    lsPlan.keys[i] = _lsKey(ls);
+    deps[i] = 0;
+
+    if (ls->func == LS_FUNC_NONE) {
+      // unused switches are not evaluated anymore: leave them off
+      for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+        LogicalSwitchContext & context = lswFm[fm].lsw[i];
+        context.state = 0;
+        context.timerState = SWITCH_START;
+        context.timer = 0;
+        context.lastValue = CS_LAST_VALUE_INIT;
+      }
+      continue;
+    }
+
+    used |= (uint64_t)1 << i;
+    deps[i] = _lsSwitchDep(ls->andsw);
+
+    // TIMER, STICKY and EDGE switches only use their sources
+    // in logicalSwitchesTimerTick()
+    uint8_t family = lswFamily(ls->func);
+    if (family == LS_FAMILY_BOOL) {
+      deps[i] |= _lsSwitchDep(ls->v1) | _lsSwitchDep(ls->v2);
+    }
+    else if (family != LS_FAMILY_TIMER && family != LS_FAMILY_STICKY &&
+             family != LS_FAMILY_EDGE) {
+      resolveSource(lsSources[i][0], ls->v1);
+      deps[i] |= _lsSourceDep(ls->v1);
+      if (family == LS_FAMILY_COMP) {
+        resolveSource(lsSources[i][1], ls->v2);
+        deps[i] |= _lsSourceDep(ls->v2);
+      }
+    }
+
+    // a switch using its own state reads it from the previous pass
+    deps[i] &= ~((uint64_t)1 << i);
+  }
+
+  // unused switches are always off: no need to wait for them
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    deps[i] &= used;
+  }
+
+  // Transitive closure of the dependency graph: a switch
+  // reaching itself is part of a loop
+  memcpy(reach, deps, sizeof(reach));
+  bool changed;
+  do {
+    changed = false;
+    for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+      uint64_t r = reach[i];
+      for (uint8_t src = 0; src < MAX_LOGICAL_SWITCHES; src++) {
+        if (reach[i] & ((uint64_t)1 << src)) r |= reach[src];
+      }
+      if (r != reach[i]) {
+        reach[i] = r;
+        changed = true;
+      }
+    }
+  } while (changed);
+
+  // Topological sort: the lowest switch with all its sources evaluated
+  // already or, if switches are waiting on each other, the lowest one
+  // only waiting on switches of its own loop
+  uint64_t done = ~used;
+  uint8_t count = 0;
+  while (done != (uint64_t)-1) {
+    uint8_t next = MAX_LOGICAL_SWITCHES;
+    for (uint8_t loops = 0; loops < 2 && next == MAX_LOGICAL_SWITCHES; loops++) {
+      for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+        uint64_t mask = (uint64_t)1 << i;
+        if (done & mask) continue;
+
+        uint64_t pending = deps[i] & ~done;
+        if (loops) {
+          for (uint8_t src = 0; src < MAX_LOGICAL_SWITCHES; src++) {
+            if (reach[src] & mask) pending &= ~((uint64_t)1 << src);
+          }
+        }
+        if (!pending) {
+          next = i;
+          break;
+        }
+      }
+    }
+    if (next >= MAX_LOGICAL_SWITCHES) break;  // should not happen
+
+    lsPlan.order[count++] = next;
+    done |= (uint64_t)1 << next;
+  }
+
+  lsPlan.count = count;
+  lsPlan.valid = true;
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentFlightmode)
 {
-  for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+  if (!_isLsPlanValid()) _buildLsPlan();
+
+  for (uint8_t i = 0; i < lsPlan.count; i++) {
+    uint8_t idx = lsPlan.order[i];
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
     bool result = getLogicalSwitch(idx);
     if (isCurrentFlightmode) {
@@ -1036,6 +1189,7 @@ int16_t lswTimerValue(delayval_t val)
 void logicalSwitchesReset()
 {
   memset(lswFm, 0, sizeof(lswFm));
+  lsPlan.valid = false;
 
   for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
     for (uint8_t i=0; i<MAX_LOGICAL_SWITCHES; i++) {
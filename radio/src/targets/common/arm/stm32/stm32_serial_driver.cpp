@@ -353,6 +353,17 @@ static void stm32_enable_rx(void* ctx)
   stm32_usart_enable_rx(st->sp->usart);
 }
 
+static uint32_t _get_rx_widx(stm32_serial_state* st)
+{
+  auto usart = st->sp->usart;
+  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
+    auto dma = usart->rxDMA;
+    auto stream = usart->rxDMA_Stream;
+    return st->sp->rx_buffer.length - LL_DMA_GetDataLength(dma, stream);
+  }
+  return st->rx_buf.widx;
+}
+
 static int stm32_serial_get_byte(void* ctx, uint8_t* data)
 {
   auto st = (stm32_serial_state*)ctx;
@@ -366,15 +377,7 @@ static int stm32_serial_get_byte(void* ctx, uint8_t* data)
   auto buf = rx_buf.buffer;
   auto& buf_st = st->rx_buf;
 
-  uint32_t widx;
-  auto usart = sp->usart;
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
+  uint32_t widx = _get_rx_widx(st);
 
   if (buf_st.ridx == widx)
     return 0;
@@ -396,17 +399,7 @@ static int stm32_serial_get_last_byte(void* ctx, uint32_t idx, uint8_t* data)
   if (!buf_len) return -1;
   
   auto buf = rx_buf.buffer;
-  auto& buf_st = st->rx_buf;
-
-  uint32_t widx;
-  auto usart = sp->usart;
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
+  uint32_t widx = _get_rx_widx(st);
 
   // Please note that we do not check the read cursor
   // so that this function might return data that
@@ -417,6 +410,36 @@ static int stm32_serial_get_last_byte(void* ctx, uint32_t idx, uint8_t* data)
   return 1;
 }
 
+static uint32_t stm32_serial_peek_rx_buffer(void* ctx, const uint8_t** data)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return 0;
+
+  const auto& rx_buf = st->sp->rx_buffer;
+  auto buf_len = rx_buf.length;
+  if (!buf_len) return 0;
+
+  uint32_t ridx = st->rx_buf.ridx;
+  uint32_t widx = _get_rx_widx(st);
+  if (ridx == widx) return 0;
+
+  // contiguous bytes only: the caller peeks again after a wrap
+  *data = rx_buf.buffer + ridx;
+  return (widx > ridx ? widx : buf_len) - ridx;
+}
+
+static void stm32_serial_consume_rx_buffer(void* ctx, uint32_t len)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return;
+
+  auto buf_len = st->sp->rx_buffer.length;
+  if (!buf_len) return;
+
+  auto& buf_st = st->rx_buf;
+  buf_st.ridx = (buf_st.ridx + len) & (buf_len - 1);
+}
+
 static void stm32_serial_clear_rx_buffer(void* ctx)
 {
   auto st = (stm32_serial_state*)ctx;
@@ -486,6 +509,8 @@ const etx_serial_driver_t STM32SerialDriver = {
   .enableRx = stm32_enable_rx,
   .getByte = stm32_serial_get_byte,
   .getLastByte = stm32_serial_get_last_byte,
+  .peekRxBuffer = stm32_serial_peek_rx_buffer,
+  .consumeRxBuffer = stm32_serial_consume_rx_buffer,
   .clearRxBuffer = stm32_serial_clear_rx_buffer,
   .getBaudrate = stm32_serial_get_baudrate,
   .setBaudrate = stm32_serial_set_baudrate,
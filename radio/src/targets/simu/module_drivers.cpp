@@ -77,6 +77,8 @@ const etx_serial_driver_t _fakeSerialDriver = {
     .enableRx = nullptr,
     .getByte = getByte,
     .getLastByte = nullptr,
+    .peekRxBuffer = nullptr,
+    .consumeRxBuffer = nullptr,
     .clearRxBuffer = nullptr,
     .getBaudrate = nullptr,
     .setBaudrate = nullptr,
@@ -613,6 +613,8 @@ static const etx_serial_driver_t _fake_drv = {
   .enableRx = nullptr,
   .getByte = _fake_drv_get_byte,
   .getLastByte = nullptr,
+  .peekRxBuffer = nullptr,
+  .consumeRxBuffer = nullptr,
   .clearRxBuffer = nullptr,
   .getBaudrate = nullptr,
   .setBaudrate = nullptr,
@@ -19,60 +19,38 @@
  * GNU General Public License for more details.
  */
 
-#if defined(SIMU_DISKIO)
 #include "opentx.h"
-#include "ff.h"
-#include "diskio.h"
+#include "simudisk.h"
+#include "hal/fatfs_diskio.h"
 #include <time.h>
 #include <stdio.h>
+#include <string>
 #include <sys/stat.h>
 
-FILE * diskImage = 0;
-
-bool _g_FATFS_init = false;
-
-RTOS_MUTEX_HANDLE ioMutex;
-
-int ff_cre_syncobj (BYTE vol, FF_SYNC_t* sobj) /* Create a sync object */
-{
-  pthread_mutex_init(&ioMutex, 0);
-  return 1;
-}
+#if defined(DISK_CACHE)
+  #include "disk_cache.h"
+#endif
 
-int ff_req_grant (FF_SYNC_t sobj)        /* Lock sync object */
-{
-  pthread_mutex_lock(&ioMutex);
-  return 1;
-}
+// Disk driver working on an image of the whole SD card. It is used by the
+// SIMU_DISKIO builds, and by the tests to run the disk cache on a real disk.
 
-void ff_rel_grant (FF_SYNC_t sobj)        /* Unlock sync object */
-{
-  pthread_mutex_unlock(&ioMutex);
-}
+SimuDiskStats simuDiskStats;
 
-int ff_del_syncobj (FF_SYNC_t sobj)        /* Delete a sync object */
-{
-  pthread_mutex_destroy(&ioMutex);
-  return 1;
-}
+static FILE * diskImage = nullptr;
+static std::string diskImagePath = "sdcard.image";
 
-DWORD get_fattime (void)
+void simuDiskSetImage(const char * path)
 {
-  time_t tim = time(0);
-  const struct tm * t = gmtime(&tim);
-
-  /* Pack date and time into a DWORD variable */
-  return ((DWORD)(t->tm_year - 80) << 25)
-    | ((uint32_t)(t->tm_mon+1) << 21)
-    | ((uint32_t)t->tm_mday << 16)
-    | ((uint32_t)t->tm_hour << 11)
-    | ((uint32_t)t->tm_min << 5)
-    | ((uint32_t)t->tm_sec >> 1);
+  if (diskImage) {
+    fclose(diskImage);
+    diskImage = nullptr;
+  }
+  diskImagePath = path;
 }
 
-unsigned int noDiskStatus = 0;
+static unsigned int noDiskStatus = 0;
 
-void traceDiskStatus()
+static void traceDiskStatus()
 {
   if (noDiskStatus > 0) {
     TRACE_SIMPGMSPACE("disk_status() called %d times", noDiskStatus);
@@ -80,42 +58,48 @@ void traceDiskStatus()
   }
 }
 
-DSTATUS disk_initialize (BYTE pdrv)
+static DSTATUS simuDiskInitialize(BYTE pdrv)
 {
   traceDiskStatus();
   TRACE_SIMPGMSPACE("disk_initialize(%u)", pdrv);
-  diskImage = fopen("sdcard.image", "rb+");
+  if (!diskImage) {
+    diskImage = fopen(diskImagePath.c_str(), "rb+");
+  }
   return diskImage ? (DSTATUS)0 : (DSTATUS)STA_NODISK;
 }
 
-DSTATUS disk_status (BYTE pdrv)
+static DSTATUS simuDiskStatus(BYTE pdrv)
 {
   ++noDiskStatus;
   // TRACE_SIMPGMSPACE("disk_status(%u)", pdrv);
   return (DSTATUS)0;
 }
 
-DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+static DRESULT simuDiskRead(BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
 {
   if (diskImage == 0) return RES_NOTRDY;
   traceDiskStatus();
   TRACE_SIMPGMSPACE("disk_read(%u, %p, %u, %u)", pdrv, buff, sector, count);
+  simuDiskStats.reads++;
+  simuDiskStats.readSectors += count;
   fseek(diskImage, sector*512, SEEK_SET);
   fread(buff, count, 512, diskImage);
   return RES_OK;
 }
 
-DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+static DRESULT simuDiskWrite(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
 {
   if (diskImage == 0) return RES_NOTRDY;
   traceDiskStatus();
   TRACE_SIMPGMSPACE("disk_write(%u, %p, %u, %u)", pdrv, buff, sector, count);
+  simuDiskStats.writes++;
+  simuDiskStats.writtenSectors += count;
   fseek(diskImage, sector*512, SEEK_SET);
   fwrite(buff, count, 512, diskImage);
   return RES_OK;
 }
 
-DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
+static DRESULT simuDiskIoctl(BYTE pdrv, BYTE cmd, void* buff)
 {
   if (diskImage == 0) return RES_NOTRDY;
   traceDiskStatus();
@@ -146,12 +130,14 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
   switch(cmd) {
 /* Generic command (Used by FatFs) */
     case CTRL_SYNC :     /* Complete pending write process (needed at _FS_READONLY == 0) */
+      simuDiskStats.syncs++;
+      fflush(diskImage);
       break;
 
     case GET_SECTOR_COUNT: /* Get media size (needed at _USE_MKFS == 1) */
       {
         struct stat buf;
-        if (stat("sdcard.image", &buf) == 0) {
+        if (stat(diskImagePath.c_str(), &buf) == 0) {
           DWORD noSectors  = buf.st_size / 512;
           *(DWORD*)buff = noSectors;
           TRACE_SIMPGMSPACE("disk_ioctl(GET_SECTOR_COUNT) = %u", noSectors);
@@ -198,6 +184,101 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
   return RES_OK;
 }
 
+const diskio_driver_t simuDiskDriver = {
+  .initialize = simuDiskInitialize,
+  .status = simuDiskStatus,
+  .read = simuDiskRead,
+  .write = simuDiskWrite,
+  .ioctl = simuDiskIoctl,
+};
+
+#if defined(SIMU_DISKIO)
+#include "ff.h"
+#include "diskio.h"
+
+bool _g_FATFS_init = false;
+
+RTOS_MUTEX_HANDLE ioMutex;
+
+int ff_cre_syncobj (BYTE vol, FF_SYNC_t* sobj) /* Create a sync object */
+{
+  pthread_mutex_init(&ioMutex, 0);
+  return 1;
+}
+
+int ff_req_grant (FF_SYNC_t sobj)        /* Lock sync object */
+{
+  pthread_mutex_lock(&ioMutex);
+  return 1;
+}
+
+void ff_rel_grant (FF_SYNC_t sobj)        /* Unlock sync object */
+{
+  pthread_mutex_unlock(&ioMutex);
+}
+
+int ff_del_syncobj (FF_SYNC_t sobj)        /* Delete a sync object */
+{
+  pthread_mutex_destroy(&ioMutex);
+  return 1;
+}
+
+DWORD get_fattime (void)
+{
+  time_t tim = time(0);
+  const struct tm * t = gmtime(&tim);
+
+  /* Pack date and time into a DWORD variable */
+  return ((DWORD)(t->tm_year - 80) << 25)
+    | ((uint32_t)(t->tm_mon+1) << 21)
+    | ((uint32_t)t->tm_mday << 16)
+    | ((uint32_t)t->tm_hour << 11)
+    | ((uint32_t)t->tm_min << 5)
+    | ((uint32_t)t->tm_sec >> 1);
+}
+
+#if defined(DISK_CACHE)
+  #define SIMU_DISK_READ   disk_cache_read
+  #define SIMU_DISK_WRITE  disk_cache_write
+  #define SIMU_DISK_IOCTL  disk_cache_ioctl
+#else
+  #define SIMU_DISK_READ   simuDiskDriver.read
+  #define SIMU_DISK_WRITE  simuDiskDriver.write
+  #define SIMU_DISK_IOCTL  simuDiskDriver.ioctl
+#endif
+
+DSTATUS disk_initialize (BYTE pdrv)
+{
+#if defined(DISK_CACHE)
+  static bool diskCacheInitialized = false;
+  if (!diskCacheInitialized) {
+    diskCache.initialize(&simuDiskDriver);
+    diskCacheInitialized = true;
+  }
+#endif
+  return simuDiskDriver.initialize(pdrv);
+}
+
+DSTATUS disk_status (BYTE pdrv)
+{
+  return simuDiskDriver.status(pdrv);
+}
+
+DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+{
+  return SIMU_DISK_READ(pdrv, buff, sector, count);
+}
+
+DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+{
+  return SIMU_DISK_WRITE(pdrv, buff, sector, count);
+}
+
+DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
+{
+  return SIMU_DISK_IOCTL(pdrv, cmd, buff);
+}
+
 void sdInit(void)
 {
   // ioMutex = CoCreateMutex();
@@ -238,6 +319,9 @@ void sdDone()
 #endif
 #if defined(LOG_BLUETOOTH)
     f_close(&g_bluetoothFile);
+#endif
+#if defined(DISK_CACHE)
+    diskCache.flush();
 #endif
     f_mount(NULL, "", 0); // unmount SD
   }
@@ -246,9 +330,11 @@ void sdDone()
 void sdMount()
 {
   TRACE("sdMount");
-  
+
+#if defined(DISK_CACHE)
   diskCache.clear();
-  
+#endif
+
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
     // call sdGetFreeSectors() now because f_getfree() takes a long time first time it's called
     _g_FATFS_init = true;
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct diskio_driver_t;
+
+// SD card image driver, "sdcard.image" by default
+extern const diskio_driver_t simuDiskDriver;
+
+// the image is opened by the next driver initialize
+void simuDiskSetImage(const char * path);
+
+struct SimuDiskStats {
+  uint32_t reads;
+  uint32_t readSectors;
+  uint32_t writes;
+  uint32_t writtenSectors;
+  uint32_t syncs;
+};
+
+extern SimuDiskStats simuDiskStats;
@@ -617,6 +617,7 @@ FRESULT f_getfree (const TCHAR* path, DWORD* nclst, FATFS** fatfs)
 
 void storageInit() {}
 void storagePreMountHook() {}
+void storagePreUnmountHook() {}
 bool storageIsPresent() { return true; }
 
 #endif  // #if defined(SIMU_USE_SDCARD)
@@ -19,8 +19,16 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
+
 #include "timers_driver.h"
 
 void watchdogSuspend(unsigned int) {}
-uint32_t timersGetUsTick() { return 0; }
+
+uint32_t timersGetUsTick()
+{
+  static auto start = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
 
@@ -22,6 +22,7 @@
 #include "tasks.h"
 #include "mixer_task.h"
 #include "mixer_scheduler.h"
+#include "mixer_stats.h"
 
 #include "opentx.h"
 #include "switches.h"
@@ -82,6 +83,7 @@ void mixerTaskStop()
 {
   mixerTaskLock();
   _mixer_running = false;
+  mixerStatsPause();
   mixerTaskUnlock();
 }
 
@@ -188,13 +190,21 @@ TASK_FUNCTION(mixerTask)
     if (_mixer_running) {
 
       uint32_t t0 = timersGetUsTick();
+      uint16_t period = getMixerSchedulerPeriod();
+      mixerStatsCycleStart(t0, period);
 
       DEBUG_TIMER_START(debugTimerMixer);
       mixerTaskLock();
 
       doMixerCalculations();
+      uint32_t t = timersGetUsTick();
       pulsesSendChannels();
+      t = mixerStatsStage(MIXER_STAGE_PULSES, t);
       doMixerPeriodicUpdates();
+#if defined(SDCARD)
+      logsHighRateSample();
+#endif
+      mixerStatsStage(MIXER_STAGE_PERIODIC, t);
 
       // TODO: what are these for???
       DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
@@ -216,6 +226,7 @@ TASK_FUNCTION(mixerTask)
       t0 = timersGetUsTick() - t0;
       if (t0 > maxMixerDuration)
         maxMixerDuration = t0;
+      mixerStatsCycleEnd(t0, period);
     }
   }
 
@@ -242,15 +253,20 @@ void doMixerCalculations()
   // therefore forget the exact calculation and use only 1 instead; good compromise
   lastTMR = tmr10ms;
 
+  uint32_t t = timersGetUsTick();
+
   DEBUG_TIMER_START(debugTimerGetAdc);
   getADC();
   DEBUG_TIMER_STOP(debugTimerGetAdc);
+  t = mixerStatsStage(MIXER_STAGE_ADC, t);
 
   DEBUG_TIMER_START(debugTimerGetSwitches);
   getSwitchesPosition(!s_mixer_first_run_done);
   DEBUG_TIMER_STOP(debugTimerGetSwitches);
+  t = mixerStatsStage(MIXER_STAGE_SWITCHES, t);
 
   DEBUG_TIMER_START(debugTimerEvalMixes);
   evalMixes(tick10ms);
   DEBUG_TIMER_STOP(debugTimerEvalMixes);
+  mixerStatsStage(MIXER_STAGE_MIXES, t);
 }
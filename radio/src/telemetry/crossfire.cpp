@@ -95,11 +95,10 @@ void processCrossfireTelemetryValue(uint8_t index, int32_t value)
 }
 
 template<int N>
-bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
+bool getCrossfireTelemetryValue(const uint8_t * frame, uint8_t index, int32_t & value)
 {
-  uint8_t * rxBuffer = getTelemetryRxBuffer(module);
   bool result = false;
-  uint8_t * byte = &rxBuffer[index];
+  const uint8_t * byte = &frame[index];
   value = (*byte & 0x80) ? -1 : 0;
   for (uint8_t i=0; i<N; i++) {
     value <<= 8;
@@ -111,42 +110,39 @@ bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
   return result;
 }
 
-void processCrossfireTelemetryFrame(uint8_t module)
+void processCrossfireTelemetryFrame(uint8_t module, const uint8_t * frame, uint8_t len)
 {
-  uint8_t * rxBuffer = getTelemetryRxBuffer(module);
-  uint8_t &rxBufferCount = getTelemetryRxBufferCount(module);
-
   if (telemetryState == TELEMETRY_INIT &&
       moduleState[module].counter != CRSF_FRAME_MODELID_SENT) {
     moduleState[module].counter = CRSF_FRAME_MODELID;
   }
 
-  uint8_t crsfPayloadLen = rxBuffer[1];
-  uint8_t id = rxBuffer[2];
+  uint8_t crsfPayloadLen = frame[1];
+  uint8_t id = frame[2];
   int32_t value;
   switch(id) {
     case CF_VARIO_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 3, value))
         processCrossfireTelemetryValue(VERTICAL_SPEED_INDEX, value);
       break;
 
     case GPS_ID:
-      if (getCrossfireTelemetryValue<4>(3, value, module))
+      if (getCrossfireTelemetryValue<4>(frame, 3, value))
         processCrossfireTelemetryValue(GPS_LATITUDE_INDEX, value/10);
-      if (getCrossfireTelemetryValue<4>(7, value, module))
+      if (getCrossfireTelemetryValue<4>(frame, 7, value))
         processCrossfireTelemetryValue(GPS_LONGITUDE_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(11, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 11, value))
         processCrossfireTelemetryValue(GPS_GROUND_SPEED_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(13, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 13, value))
         processCrossfireTelemetryValue(GPS_HEADING_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(15, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 15, value))
         processCrossfireTelemetryValue(GPS_ALTITUDE_INDEX,  value - 1000);
-      if (getCrossfireTelemetryValue<1>(17, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 17, value))
         processCrossfireTelemetryValue(GPS_SATELLITES_INDEX, value);
       break;
 
     case BARO_ALT_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module)) {
+      if (getCrossfireTelemetryValue<2>(frame, 3, value)) {
         if (value & 0x8000) {
           // Altitude in meters
           value &= ~(0x8000);
@@ -160,13 +156,13 @@ void processCrossfireTelemetryFrame(uint8_t module)
       }
       // Length of TBS BARO_ALT has 4 payload bytes with just 2 bytes of altitude
       // but support including VARIO if the declared payload length is 6 bytes or more
-      if (crsfPayloadLen > 5 && getCrossfireTelemetryValue<2>(5, value, module))
+      if (crsfPayloadLen > 5 && getCrossfireTelemetryValue<2>(frame, 5, value))
         processCrossfireTelemetryValue(VERTICAL_SPEED_INDEX, value);
       break;
 
     case LINK_ID:
       for (unsigned int i=0; i<=TX_SNR_INDEX; i++) {
-        if (getCrossfireTelemetryValue<1>(3+i, value, module)) {
+        if (getCrossfireTelemetryValue<1>(frame, 3+i, value)) {
           if (i == TX_POWER_INDEX) {
             static const int32_t power_values[] = {0,    10,   25,  100, 500,
                                                    1000, 2000, 250, 50};
@@ -193,60 +189,63 @@ void processCrossfireTelemetryFrame(uint8_t module)
       break;
 
     case LINK_RX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 4, value))
         processCrossfireTelemetryValue(RX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 7, value))
         processCrossfireTelemetryValue(TX_RF_POWER_INDEX, value);
       break;
 
     case LINK_TX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 4, value))
         processCrossfireTelemetryValue(TX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 7, value))
         processCrossfireTelemetryValue(RX_RF_POWER_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(8, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 8, value))
         processCrossfireTelemetryValue(TX_FPS_INDEX, value * 10);
       break;
 
     case BATTERY_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 3, value))
         processCrossfireTelemetryValue(BATT_VOLTAGE_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(5, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 5, value))
         processCrossfireTelemetryValue(BATT_CURRENT_INDEX, value);
-      if (getCrossfireTelemetryValue<3>(7, value, module))
+      if (getCrossfireTelemetryValue<3>(frame, 7, value))
         processCrossfireTelemetryValue(BATT_CAPACITY_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(10, value, module))
+      if (getCrossfireTelemetryValue<1>(frame, 10, value))
         processCrossfireTelemetryValue(BATT_REMAINING_INDEX, value);
       break;
 
     case ATTITUDE_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 3, value))
         processCrossfireTelemetryValue(ATTITUDE_PITCH_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(5, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 5, value))
         processCrossfireTelemetryValue(ATTITUDE_ROLL_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(7, value, module))
+      if (getCrossfireTelemetryValue<2>(frame, 7, value))
         processCrossfireTelemetryValue(ATTITUDE_YAW_INDEX, value/10);
       break;
 
     case FLIGHT_MODE_ID:
     {
       const CrossfireSensor & sensor = crossfireSensors[FLIGHT_MODE_INDEX];
-      auto textLength = min<int>(16, rxBuffer[1]);
-      rxBuffer[textLength] = '\0';
+      // the frame may be the receive buffer itself: terminate a copy
+      char text[16];
+      auto textLength = min<int>(16, frame[1]) - 3;
+      memcpy(text, frame + 3, textLength);
+      text[textLength] = '\0';
       setTelemetryText(PROTOCOL_TELEMETRY_CROSSFIRE, sensor.id, 0, sensor.subId,
-                       (const char *)rxBuffer + 3);
+                       text);
       break;
     }
 
     case RADIO_ID:
-      if (rxBuffer[3] == 0xEA     // radio address
-          && rxBuffer[5] == 0x10  // timing correction frame
+      if (frame[3] == 0xEA     // radio address
+          && frame[5] == 0x10  // timing correction frame
       ) {
         uint32_t update_interval;
         int32_t offset;
-        if (getCrossfireTelemetryValue<4>(6, (int32_t &)update_interval,
-                                          module) &&
-            getCrossfireTelemetryValue<4>(10, offset, module)) {
+        if (getCrossfireTelemetryValue<4>(frame, 6,
+                                          (int32_t &)update_interval) &&
+            getCrossfireTelemetryValue<4>(frame, 10, offset)) {
           // values are in 10th of micro-seconds
           update_interval /= 10;
           offset /= 10;
@@ -259,10 +258,10 @@ void processCrossfireTelemetryFrame(uint8_t module)
 
 #if defined(LUA)
     default:
-      if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(rxBufferCount-2) ) {
-        for (uint8_t i=1; i<rxBufferCount-1; i++) {
+      if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(len-2) ) {
+        for (uint8_t i=1; i<len-1; i++) {
           // destination address and CRC are skipped
-          luaInputTelemetryFifo->push(rxBuffer[i]);
+          luaInputTelemetryFifo->push(frame[i]);
         }
       }
       break;
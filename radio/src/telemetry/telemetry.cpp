@@ -200,6 +200,16 @@ void telemetryMirrorSend(uint8_t data)
   }
 }
 
+void telemetryMirrorSendBuffer(const uint8_t* data, uint32_t len)
+{
+  auto _sendByte = telemetryMirrorSendByte;
+  auto _ctx = telemetryMirrorSendByteCtx;
+
+  if (_sendByte) {
+    while (len--) _sendByte(_ctx, *data++);
+  }
+}
+
 #if !defined(SIMU)
 static TimerHandle_t telemetryTimer = nullptr;
 static StaticTimer_t telemetryTimerBuffer;
@@ -262,12 +272,39 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
   auto serial_drv = modulePortGetSerialDrv(mod_st->rx);
   auto serial_ctx = modulePortGetCtx(mod_st->rx);
 
-  if (!serial_drv  || !serial_ctx || !serial_drv->getByte)
+  if (!serial_drv  || !serial_ctx)
     return;
 
   uint8_t* rxBuffer = getTelemetryRxBuffer(module);
   uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
 
+  if (serial_drv->peekRxBuffer && serial_drv->consumeRxBuffer) {
+    // process the received data in place, one contiguous span at a time
+    const uint8_t* data;
+    uint32_t len = serial_drv->peekRxBuffer(serial_ctx, &data);
+    if (len > 0) {
+      LOG_TELEMETRY_WRITE_START();
+      do {
+        telemetryMirrorSendBuffer(data, len);
+        if (drv->processBlock) {
+          drv->processBlock(ctx, data, len, rxBuffer, &rxBufferCount);
+        } else {
+          for (uint32_t i = 0; i < len; i++)
+            drv->processData(ctx, data[i], rxBuffer, &rxBufferCount);
+        }
+#if defined(LOG_TELEMETRY) && !defined(SIMU)
+        for (uint32_t i = 0; i < len; i++)
+          LOG_TELEMETRY_WRITE_BYTE(data[i]);
+#endif
+        serial_drv->consumeRxBuffer(serial_ctx, len);
+      } while ((len = serial_drv->peekRxBuffer(serial_ctx, &data)) > 0);
+    }
+    return;
+  }
+
+  if (!serial_drv->getByte)
+    return;
+
   uint8_t data;
   if (serial_drv->getByte(serial_ctx, &data) > 0) {
     LOG_TELEMETRY_WRITE_START();
@@ -294,12 +331,7 @@ void telemetryWakeup()
   }
   _telemetryIsPolling = false;
 
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -72,6 +72,7 @@ void telemetrySetMirrorCb(void* ctx, void (*fct)(void*, uint8_t));
 
 // Mirror telemetry byte
 void telemetryMirrorSend(uint8_t data);
+void telemetryMirrorSendBuffer(const uint8_t* data, uint32_t len);
 
 void telemetryWakeup();
 void telemetryReset();
@@ -117,6 +118,11 @@ int setTelemetryText(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uin
 void delTelemetryIndex(uint8_t index);
 int availableTelemetryIndex();
 int lastUsedTelemetryIndex();
+void telemetrySensorsChanged();
+// Never 0, changes after each telemetrySensorsChanged()
+uint8_t telemetrySensorsVersion();
+// Evaluate the calculated sensors with a source changed since the last call
+void evalCalculatedSensors();
 
 int32_t convertTelemetryValue(int32_t value, uint8_t unit, uint8_t prec, uint8_t destUnit, uint8_t destPrec);
 
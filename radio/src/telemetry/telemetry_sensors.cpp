@@ -350,7 +350,7 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
 
     case TELEM_FORMULA_DIST:
       if (sensor.dist.gps) {
-        TelemetryItem gpsItem = telemetryItems[sensor.dist.gps-1];
+        TelemetryItem & gpsItem = telemetryItems[sensor.dist.gps-1];
         TelemetryItem * altItem = nullptr;
         if (!gpsItem.isAvailable()) {
           return;
@@ -496,6 +496,211 @@ int lastUsedTelemetryIndex()
   return -1;
 }
 
+// Custom sensors sorted by id and subId, so that setTelemetryValue() does not
+// have to go through all the sensors for each received value. It is rebuilt
+// on the next value after telemetrySensorsChanged(), which is called on each
+// model change (see storageDirty()).
+static uint8_t sensorsIndex[MAX_TELEMETRY_SENSORS];
+static uint8_t sensorsIndexCount;
+static volatile uint8_t sensorsChanges = 1;
+static volatile uint8_t sensorsIndexVersion;  // 0 while it is rebuilt
+
+void telemetrySensorsChanged()
+{
+  uint8_t changes = sensorsChanges + 1;
+  sensorsChanges = (changes ? changes : 1);
+}
+
+uint8_t telemetrySensorsVersion()
+{
+  return sensorsChanges;
+}
+
+static uint32_t sensorKey(const TelemetrySensor & sensor)
+{
+  return (sensor.id << 8) + sensor.subId;
+}
+
+static void buildSensorsIndex(uint8_t version)
+{
+  sensorsIndexVersion = 0;
+  uint8_t count = 0;
+  for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    if (sensor.type != TELEM_TYPE_CUSTOM)
+      continue;
+    // sensors with the same key stay in their order
+    uint32_t key = sensorKey(sensor);
+    uint8_t pos = count++;
+    while (pos > 0 && sensorKey(g_model.telemetrySensors[sensorsIndex[pos - 1]]) > key) {
+      sensorsIndex[pos] = sensorsIndex[pos - 1];
+      pos--;
+    }
+    sensorsIndex[pos] = index;
+  }
+  sensorsIndexCount = count;
+  sensorsIndexVersion = version;
+}
+
+// Calculated sensors computed by TelemetryItem::eval(), sorted so that a
+// sensor comes after the calculated sensors it uses as source. Sensors may
+// be modified without telemetrySensorsChanged(): it is rebuilt when the
+// type, formula or sources of a sensor change.
+static uint8_t calcSensors[MAX_TELEMETRY_SENSORS];
+static uint8_t calcSensorsCount;
+static uint64_t calcSensorsKeys[MAX_TELEMETRY_SENSORS];
+
+static_assert(MAX_TELEMETRY_SENSORS <= 64, "sensors masks are 64 bits");
+
+static inline uint64_t sensorMask(unsigned int source)
+{
+  return (source > 0 && source <= MAX_TELEMETRY_SENSORS) ? (uint64_t)1 << (source - 1) : 0;
+}
+
+static bool isEvalFormula(uint8_t formula)
+{
+  return formula <= TELEM_FORMULA_MULTIPLY || formula == TELEM_FORMULA_CELL ||
+         formula == TELEM_FORMULA_DIST;
+}
+
+// The sensors read by TelemetryItem::eval()
+static uint64_t calcSensorSources(const TelemetrySensor & sensor)
+{
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      return sensorMask(sensor.cell.source);
+
+    case TELEM_FORMULA_DIST:
+      return sensorMask(sensor.dist.gps) | sensorMask(sensor.dist.alt);
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+    {
+      uint64_t sources = 0;
+      int maxitems = (sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4);
+      for (int i = 0; i < maxitems; i++) {
+        sources |= sensorMask(abs(sensor.calc.sources[i]));
+      }
+      return sources;
+    }
+
+    default:
+      return 0;
+  }
+}
+
+static inline uint64_t calcSensorKey(const TelemetrySensor & sensor)
+{
+  return ((uint64_t)sensor.param << 8) | (sensor.formula << 1) | sensor.type;
+}
+
+static bool isCalculatedSensorsValid()
+{
+  for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    if (calcSensorKey(g_model.telemetrySensors[index]) != calcSensorsKeys[index])
+      return false;
+  }
+  return true;
+}
+
+static void buildCalculatedSensors()
+{
+  uint64_t sources[MAX_TELEMETRY_SENSORS];
+  uint64_t calculated = 0;
+
+  for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    calcSensorsKeys[index] = calcSensorKey(sensor);
+    sources[index] = 0;
+    if (sensor.type == TELEM_TYPE_CALCULATED && isEvalFormula(sensor.formula)) {
+      sources[index] = calcSensorSources(sensor);
+      calculated |= (uint64_t)1 << index;
+    }
+  }
+
+  // the lowest sensor with all its sources done or, if sensors
+  // use each other, the lowest one left
+  uint64_t done = ~calculated;
+  uint8_t count = 0;
+  while (done != (uint64_t)-1) {
+    uint8_t next = MAX_TELEMETRY_SENSORS;
+    uint8_t first = MAX_TELEMETRY_SENSORS;
+    for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      if (done & ((uint64_t)1 << index))
+        continue;
+      if (first == MAX_TELEMETRY_SENSORS)
+        first = index;
+      if (!(sources[index] & ~done)) {
+        next = index;
+        break;
+      }
+    }
+    if (next == MAX_TELEMETRY_SENSORS)
+      next = first;
+    calcSensors[count++] = next;
+    done |= (uint64_t)1 << next;
+  }
+  calcSensorsCount = count;
+}
+
+void evalCalculatedSensors()
+{
+  uint64_t changed = 0;
+
+  if (!isCalculatedSensorsValid()) {
+    buildCalculatedSensors();
+    // the formulas may have changed
+    changed = (uint64_t)-1;
+  }
+
+  // values received from now on are for the next call
+  for (uint8_t index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    TelemetryItem & item = telemetryItems[index];
+    if (item.changed) {
+      item.changed = 0;
+      changed |= (uint64_t)1 << index;
+    }
+  }
+
+  for (uint8_t i = 0; i < calcSensorsCount; i++) {
+    uint8_t index = calcSensors[i];
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    // without any source, the result is a constant kept fresh
+    uint64_t sources = calcSensorSources(sensor);
+    if (sources && !(sources & changed))
+      continue;
+
+    TelemetryItem & item = telemetryItems[index];
+    item.eval(sensor);
+    // the next sensors see the new value in the same call
+    if (item.changed) {
+      item.changed = 0;
+      changed |= (uint64_t)1 << index;
+    }
+  }
+}
+
+template <class T>
+static bool setSensorValue(uint8_t index, TelemetryProtocol protocol,
+                           uint16_t id, uint8_t subId, uint8_t instance,
+                           T value, uint32_t unit, uint32_t prec)
+{
+  TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+
+  if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
+      telemetrySensor.subId == subId &&
+      (telemetrySensor.isSameInstance(protocol, instance) ||
+       g_model.ignoreSensorIds)) {
+    telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+    return true;
+  }
+
+  return false;
+}
+
 template <class T>
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
                       uint8_t instance, T value, uint32_t unit = 0,
@@ -503,18 +708,42 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
-    TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
-
-    if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
-        telemetrySensor.subId == subId &&
-        (telemetrySensor.isSameInstance(protocol, instance) ||
-         g_model.ignoreSensorIds)) {
+  uint8_t changes = sensorsChanges;
+  if (sensorsIndexVersion != changes) {
+    buildSensorsIndex(changes);
+  }
+
+  // the index may be rebuilt by another task
+  bool indexed = (sensorsIndexVersion == changes);
+  if (indexed) {
+    uint32_t key = ((uint32_t)id << 8) + subId;
+    uint8_t first = 0, last = sensorsIndexCount;
+    while (first < last) {
+      uint8_t mid = (first + last) / 2;
+      if (sensorKey(g_model.telemetrySensors[sensorsIndex[mid]]) < key)
+        first = mid + 1;
+      else
+        last = mid;
+    }
+    // sensors can share the same id and instance
+    for (; first < sensorsIndexCount; first++) {
+      uint8_t index = sensorsIndex[first];
+      if (sensorKey(g_model.telemetrySensors[index]) != key)
+        break;
+      if (setSensorValue(index, protocol, id, subId, instance, value, unit, prec))
+        sensorFound = true;
+    }
+  }
 
-      telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
-      sensorFound = true;
-      // we continue search here, because sensors can share the same id and
-      // instance
+  // before a new sensor is added, check that the index did not miss a sensor
+  // modified without telemetrySensorsChanged()
+  if (!indexed || (!sensorFound && allowNewSensors)) {
+    for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      if (setSensorValue(index, protocol, id, subId, instance, value, unit, prec))
+        sensorFound = true;
+    }
+    if (indexed && sensorFound) {
+      telemetrySensorsChanged();
     }
   }
 
@@ -524,6 +753,7 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 
   int index = availableTelemetryIndex();
   if (index >= 0) {
+    telemetrySensorsChanged();
     switch (protocol) {
       case PROTOCOL_TELEMETRY_FRSKY_SPORT:
         frskySportSetDefault(index, id, subId, instance);
@@ -48,6 +48,7 @@ class TelemetryItem
     };
 
     int8_t timeout; // for detection of sensor loss
+    uint8_t changed; // new value or state, cleared by evalCalculatedSensors()
 
     union {
       struct {
@@ -88,6 +89,7 @@ class TelemetryItem
     {
       memset(reinterpret_cast<void*>(this), 0, sizeof(TelemetryItem));
       timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
+      changed = 1;
     }
 
     void eval(const TelemetrySensor & sensor);
@@ -125,11 +127,13 @@ class TelemetryItem
     inline void setFresh()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_START;
+      changed = 1;
     }
 
     inline void setOld()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
+      changed = 1;
     }
 };
 
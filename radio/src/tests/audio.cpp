@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string>
+
+#include "gtests.h"
+#include "location.h"
+
+static void createAudioFile(const char * filename, bool lowercase = false)
+{
+  char path[AUDIO_FILENAME_MAXLEN+1];
+  strcpy(path, filename);
+  if (lowercase) {
+    for (char * c = strrchr(path, '/') + 1; *c; c++)
+      *c = tolower(*c);
+  }
+  FIL file;
+  ASSERT_EQ(FR_OK, f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE));
+  f_close(&file);
+}
+
+TEST(Audio, referenceModelAudioFiles)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  strcpy(g_model.flightModeData[1].name, "Cruise");
+
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  char path[AUDIO_FILENAME_MAXLEN+1];
+  char * filename = getModelAudioPath(path);
+  *(filename-1) = '\0';
+  f_mkdir("/SOUNDS");
+  f_mkdir(SOUNDS_PATH);
+  f_mkdir(path);
+
+  getFlightmodeAudioFile(path, 0, AUDIO_EVENT_OFF);
+  createAudioFile(path);
+  getFlightmodeAudioFile(path, 1, AUDIO_EVENT_ON);
+  createAudioFile(path, true);
+  getSwitchAudioFile(path, SWSRC_FIRST_SWITCH + 0);
+  createAudioFile(path);
+  getSwitchAudioFile(path, SWSRC_FIRST_SWITCH + 5);
+  createAudioFile(path, true);
+  getSwitchAudioFile(path, SWSRC_FIRST_SWITCH + MAX_SWITCHES * 3 + 1);
+  createAudioFile(path);
+  getLogicalSwitchAudioFile(path, 0, AUDIO_EVENT_ON);
+  createAudioFile(path);
+  getLogicalSwitchAudioFile(path, 9, AUDIO_EVENT_OFF);
+  createAudioFile(path, true);
+  getLogicalSwitchAudioFile(path, MAX_LOGICAL_SWITCHES - 1, AUDIO_EVENT_ON);
+  createAudioFile(path);
+  for (auto name : {"L0-on.wav", "L01-off.wav", "SA-left.wav", "other.wav"}) {
+    strcpy(filename, name);
+    createAudioFile(path);
+  }
+
+  referenceModelAudioFiles();
+
+#define REFERENCED(category, index, event) \
+  isAudioFileReferenced(((category) << 24) + ((index) << 16) + (event), path)
+
+  EXPECT_TRUE(REFERENCED(PHASE_AUDIO_CATEGORY, 0, AUDIO_EVENT_OFF));
+  EXPECT_FALSE(REFERENCED(PHASE_AUDIO_CATEGORY, 0, AUDIO_EVENT_ON));
+  EXPECT_TRUE(REFERENCED(PHASE_AUDIO_CATEGORY, 1, AUDIO_EVENT_ON));
+  EXPECT_FALSE(REFERENCED(PHASE_AUDIO_CATEGORY, 2, AUDIO_EVENT_ON));
+
+  EXPECT_TRUE(REFERENCED(SWITCH_AUDIO_CATEGORY, 0, 0));
+  EXPECT_FALSE(REFERENCED(SWITCH_AUDIO_CATEGORY, 1, 0));
+  EXPECT_TRUE(REFERENCED(SWITCH_AUDIO_CATEGORY, 5, 0));
+  EXPECT_TRUE(REFERENCED(SWITCH_AUDIO_CATEGORY, MAX_SWITCHES * 3 + 1, 0));
+
+  EXPECT_TRUE(REFERENCED(LOGICAL_SWITCH_AUDIO_CATEGORY, 0, AUDIO_EVENT_ON));
+  EXPECT_FALSE(REFERENCED(LOGICAL_SWITCH_AUDIO_CATEGORY, 0, AUDIO_EVENT_OFF));
+  EXPECT_TRUE(REFERENCED(LOGICAL_SWITCH_AUDIO_CATEGORY, 9, AUDIO_EVENT_OFF));
+  EXPECT_FALSE(REFERENCED(LOGICAL_SWITCH_AUDIO_CATEGORY, 9, AUDIO_EVENT_ON));
+  EXPECT_TRUE(REFERENCED(LOGICAL_SWITCH_AUDIO_CATEGORY, MAX_LOGICAL_SWITCHES - 1, AUDIO_EVENT_ON));
+  EXPECT_FALSE(REFERENCED(LOGICAL_SWITCH_AUDIO_CATEGORY, 1, AUDIO_EVENT_OFF));
+
+#undef REFERENCED
+
+  // the file played is the one found
+  getLogicalSwitchAudioFile(path, 9, AUDIO_EVENT_OFF);
+  EXPECT_STREQ("L10-off.wav", strrchr(path, '/') + 1);
+
+  // the next runs must not find these files
+  DIR dir;
+  FILINFO fno;
+  filename = getModelAudioPath(path);
+  *(filename-1) = '\0';
+  if (f_opendir(&dir, path) == FR_OK) {
+    while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+      getModelAudioPath(path);
+      strcpy(filename, fno.fname);
+      f_unlink(path);
+    }
+    f_closedir(&dir);
+  }
+  getModelAudioPath(path);
+  *(filename-1) = '\0';
+  EXPECT_EQ(0, remove((std::string(TESTS_BUILD_PATH) + path).c_str()));
+  EXPECT_EQ(0, remove(TESTS_BUILD_PATH SOUNDS_PATH));
+  EXPECT_EQ(0, remove(TESTS_BUILD_PATH "/SOUNDS"));
+  simuFatfsSetPaths("", "");
+}
@@ -22,6 +22,10 @@
 #include "gtests.h"
 
 #if defined(CROSSFIRE)
+#include "hal/module_port.h"
+#include "pulses/crossfire.h"
+#include "telemetry/crossfire.h"
+
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
 TEST(Crossfire, createCrossfireChannelsFrame)
 {
@@ -44,5 +48,90 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+static uint32_t appendCrossfireFrame(uint8_t * p, uint8_t id,
+                                     const uint8_t * payload, uint8_t len)
+{
+  p[0] = UART_SYNC;
+  p[1] = len + 2;
+  p[2] = id;
+  memcpy(&p[3], payload, len);
+  p[len + 3] = crc8(&p[2], len + 1);
+  return len + 4;
+}
+
+static uint32_t buildCrossfireStream(uint8_t * stream)
+{
+  uint32_t len = 0;
+  for (int i = 0; i < 20; i++) {
+    uint8_t battery[] = {0, (uint8_t)(100 + i), 0, (uint8_t)i, 0, 0, 10, 50};
+    if (i == 5) {
+      // garbage between frames
+      stream[len++] = 0x55;
+      stream[len++] = UART_SYNC;
+      stream[len++] = 0xF0;
+    }
+    else if (i == 9) {
+      // CRC error
+      len += appendCrossfireFrame(&stream[len], BATTERY_ID, battery,
+                                  sizeof(battery));
+      stream[len - 1] ^= 0xFF;
+      continue;
+    }
+    else if (i == 13) {
+      // truncated frame followed by a good one
+      len += appendCrossfireFrame(&stream[len], BATTERY_ID, battery,
+                                  sizeof(battery)) - 6;
+    }
+    len += appendCrossfireFrame(&stream[len], BATTERY_ID, battery,
+                                sizeof(battery));
+  }
+  len += appendCrossfireFrame(&stream[len], FLIGHT_MODE_ID,
+                              (const uint8_t *)"ACRO", 5);
+  return len;
+}
+
+TEST(Crossfire, processBlock)
+{
+  uint8_t stream[512];
+  uint32_t streamLen = buildCrossfireStream(stream);
+
+  auto ctx = modulePortGetState(EXTERNAL_MODULE);
+  uint8_t * buffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+  uint8_t & bufferCount = getTelemetryRxBufferCount(EXTERNAL_MODULE);
+  allowNewSensors = true;
+
+  // reference: byte per byte
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  bufferCount = 0;
+  for (uint32_t i = 0; i < streamLen; i++) {
+    CrossfireDriver.processData(ctx, stream[i], buffer, &bufferCount);
+  }
+  TelemetryItem expected[MAX_TELEMETRY_SENSORS];
+  memcpy(expected, telemetryItems, sizeof(expected));
+  EXPECT_EQ(119, expected[0].value);  // last voltage
+  EXPECT_STREQ("ACRO", expected[4].text);
+
+  for (uint32_t blockLen : {1, 2, 7, 13, 64, 512}) {
+    MODEL_RESET();
+    TELEMETRY_RESET();
+    telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+    bufferCount = 0;
+    for (uint32_t i = 0; i < streamLen; i += blockLen) {
+      CrossfireDriver.processBlock(ctx, &stream[i],
+                                   min<uint32_t>(blockLen, streamLen - i),
+                                   buffer, &bufferCount);
+    }
+    EXPECT_EQ(0, bufferCount);
+    for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+      EXPECT_EQ(expected[i].value, telemetryItems[i].value) << blockLen;
+      EXPECT_EQ(expected[i].valueMin, telemetryItems[i].valueMin) << blockLen;
+      EXPECT_EQ(expected[i].valueMax, telemetryItems[i].valueMax) << blockLen;
+    }
+    EXPECT_STREQ("ACRO", telemetryItems[4].text);
+  }
+}
 #endif
 
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "location.h"
+#include "disk_cache.h"
+#include "targets/simu/simudisk.h"
+
+#define IMAGE_PATH     TESTS_BUILD_PATH "/disk_cache.image"
+#define IMAGE_SECTORS  1000  // the last cache block is not full
+
+static void fillSector(uint8_t * buff, uint32_t sector, uint8_t version)
+{
+  for (int i = 0; i < 512; i++) {
+    buff[i] = sector * 7 + i + version * 13;
+  }
+}
+
+static bool checkImage(uint32_t sector, uint8_t version)
+{
+  uint8_t expected[512], buff[512];
+  FILE * f = fopen(IMAGE_PATH, "rb");
+  fseek(f, sector * 512, SEEK_SET);
+  bool ok = (fread(buff, 512, 1, f) == 1);
+  fclose(f);
+  fillSector(expected, sector, version);
+  return ok && !memcmp(buff, expected, 512);
+}
+
+class DiskCacheTest : public testing::Test
+{
+ protected:
+  DiskCache cache;
+
+  void SetUp() override
+  {
+    FILE * f = fopen(IMAGE_PATH, "wb");
+    uint8_t buff[512];
+    for (uint32_t sector = 0; sector < IMAGE_SECTORS; sector++) {
+      fillSector(buff, sector, 0);
+      fwrite(buff, 512, 1, f);
+    }
+    fclose(f);
+
+    simuDiskSetImage(IMAGE_PATH);
+    simuDiskDriver.initialize(0);
+    cache.initialize(&simuDiskDriver);
+    memset(&simuDiskStats, 0, sizeof(simuDiskStats));
+  }
+
+  void TearDown() override
+  {
+    simuDiskSetImage("sdcard.image");
+    remove(IMAGE_PATH);
+  }
+
+  bool checkRead(uint32_t sector, uint32_t count, uint8_t version = 0)
+  {
+    std::vector<uint8_t> buff(count * 512), expected(count * 512);
+    if (cache.read(0, buff.data(), sector, count) != RES_OK) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      fillSector(&expected[i * 512], sector + i, version);
+    }
+    return buff == expected;
+  }
+
+  DRESULT write(uint32_t sector, uint32_t count, uint8_t version)
+  {
+    std::vector<uint8_t> buff(count * 512);
+    for (uint32_t i = 0; i < count; i++) {
+      fillSector(&buff[i * 512], sector + i, version);
+    }
+    return cache.write(0, buff.data(), sector, count);
+  }
+};
+
+TEST_F(DiskCacheTest, Reads)
+{
+  EXPECT_TRUE(checkRead(0, 1));
+  EXPECT_TRUE(checkRead(1, 1));
+  EXPECT_EQ(1u, cache.getStats().noMisses);
+  EXPECT_EQ(1u, cache.getStats().noHits);
+
+  // crosses a block boundary, end of the disk
+  EXPECT_TRUE(checkRead(14, 4));
+  EXPECT_TRUE(checkRead(IMAGE_SECTORS - 3, 3));
+  EXPECT_TRUE(checkRead(100, 300));
+
+  // one block, then the next two ones in one request
+  simuDiskStats.reads = 0;
+  for (uint32_t sector = 500; sector < 532; sector++) {
+    EXPECT_TRUE(checkRead(sector, 1));
+  }
+  EXPECT_EQ(2u, simuDiskStats.reads);
+  EXPECT_EQ(1u, cache.getStats().noReadAheadHits);
+}
+
+TEST_F(DiskCacheTest, WriteThrough)
+{
+  EXPECT_TRUE(checkRead(40, 1));
+  EXPECT_EQ(RES_OK, write(40, 2, 1));
+  EXPECT_EQ(1u, simuDiskStats.writes);
+  EXPECT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_TRUE(checkImage(40, 1));
+  EXPECT_TRUE(checkRead(40, 2, 1));
+}
+
+TEST_F(DiskCacheTest, WriteBackCoalesces)
+{
+  cache.setWriteBack(true);
+
+  // a file appended one sector at a time, and its FAT sector
+  for (uint32_t sector = 100; sector < 110; sector++) {
+    EXPECT_EQ(RES_OK, write(sector, 1, 1));
+    EXPECT_EQ(RES_OK, write(2, 1, sector));
+  }
+  EXPECT_EQ(0u, simuDiskStats.writes);
+  EXPECT_EQ(11u, cache.getDirtySectors());
+  EXPECT_TRUE(checkImage(100, 0));
+
+  // reads see the data not written yet
+  EXPECT_TRUE(checkRead(100, 10, 1));
+  EXPECT_TRUE(checkRead(2, 1, 109));
+
+  EXPECT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_EQ(2u, simuDiskStats.writes);
+  EXPECT_EQ(11u, simuDiskStats.writtenSectors);
+  EXPECT_EQ(1u, simuDiskStats.syncs);
+  EXPECT_EQ(0u, cache.getDirtySectors());
+  EXPECT_TRUE(checkImage(2, 109));
+  for (uint32_t sector = 100; sector < 110; sector++) {
+    EXPECT_TRUE(checkImage(sector, 1));
+  }
+}
+
+TEST_F(DiskCacheTest, WriteBackFlushes)
+{
+  cache.setWriteBack(true);
+
+  // full buffer
+  for (uint32_t sector = 0; sector <= DISK_CACHE_WRITE_SECTORS; sector++) {
+    EXPECT_EQ(RES_OK, write(sector * 2, 1, 1));
+  }
+  EXPECT_EQ((uint32_t)DISK_CACHE_WRITE_SECTORS, simuDiskStats.writtenSectors);
+  EXPECT_EQ(1u, cache.getDirtySectors());
+
+  // a big write replaces the pending sectors it covers
+  EXPECT_EQ(RES_OK, write(600, 1, 1));
+  EXPECT_EQ(RES_OK, write(590, 20, 2));
+  EXPECT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_TRUE(checkImage(600, 2));
+  EXPECT_TRUE(checkImage(DISK_CACHE_WRITE_SECTORS * 2, 1));
+
+  // disabling write-back writes everything
+  EXPECT_EQ(RES_OK, write(700, 1, 3));
+  cache.setWriteBack(false);
+  EXPECT_EQ(0u, cache.getDirtySectors());
+  EXPECT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_TRUE(checkImage(700, 3));
+}
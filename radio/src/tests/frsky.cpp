@@ -530,3 +530,126 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+
+TEST(FrSkySPORT, sensorsTable)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  struct {
+    uint16_t id;
+    uint8_t subId;
+    uint8_t unit;
+  } sensors[] = {
+    { VARIO_FIRST_ID + 3, 0, UNIT_METERS_PER_SECOND },
+    { ANGLE_FIRST_ID, 1, UNIT_DEGREE },
+    { RBOX_STATE_LAST_ID, 1, UNIT_TEXT },
+    { SERVO_FIRST_ID + 2, 3, UNIT_TEXT },
+    { R9_PWR_ID, 0, UNIT_MILLIWATTS },
+    { X8R_FIRST_ID, 0, UNIT_RAW },      // not in the table
+    { T1_FIRST_ID, 1, UNIT_RAW },       // no such subId
+  };
+
+  for (uint8_t i = 0; i < DIM(sensors); i++) {
+    EXPECT_EQ(i, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, sensors[i].id,
+                                   sensors[i].subId, 0, 10, UNIT_RAW, 0));
+    EXPECT_EQ(sensors[i].unit, g_model.telemetrySensors[i].unit);
+  }
+}
+
+TEST(Telemetry, sensorsIndex)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  // discovered in a random order
+  const int count = MAX_TELEMETRY_SENSORS - 3;
+  for (int i = 0; i < count; i++) {
+    uint16_t id = DIY_FIRST_ID + (i * 17) % count;
+    EXPECT_EQ(i, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, id, 0, 0, i, UNIT_RAW, 0));
+  }
+  for (int i = 0; i < count; i++) {
+    uint16_t id = DIY_FIRST_ID + (i * 17) % count;
+    EXPECT_EQ(-1, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, id, 0, 0, 100 + i, UNIT_RAW, 0));
+    EXPECT_EQ(100 + i, telemetryItems[i].value);
+  }
+  EXPECT_EQ(count, availableTelemetryIndex());
+
+  // two sensors with the same id
+  g_model.telemetrySensors[count] = g_model.telemetrySensors[5];
+  telemetrySensorsChanged();
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, g_model.telemetrySensors[5].id, 0, 0, 1000, UNIT_RAW, 0);
+  EXPECT_EQ(1000, telemetryItems[5].value);
+  EXPECT_EQ(1000, telemetryItems[count].value);
+
+  // a sensor added without telemetrySensorsChanged() is not added twice
+  g_model.telemetrySensors[count + 1].init(DIY_LAST_ID);
+  g_model.telemetrySensors[count + 1].id = DIY_LAST_ID;
+  EXPECT_EQ(-1, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, DIY_LAST_ID, 0, 0, 2000, UNIT_RAW, 0));
+  EXPECT_EQ(2000, telemetryItems[count + 1].value);
+  EXPECT_EQ(count + 2, availableTelemetryIndex());
+
+  // a deleted sensor is discovered again
+  uint16_t id = g_model.telemetrySensors[3].id;
+  delTelemetryIndex(3);
+  EXPECT_EQ(3, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, id, 0, 0, 3000, UNIT_RAW, 0));
+
+  // ids not matching any sensor are not added when discovery is off
+  allowNewSensors = false;
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ(-1, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, DIY_STREAM_FIRST_ID + i, 0, 0, i, UNIT_RAW, 0));
+  }
+  EXPECT_EQ(count + 2, availableTelemetryIndex());
+}
+
+TEST(Telemetry, calculatedSensors)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  // sensor 2 adds sensor 1, sensor 3 adds sensor 2, sensor 4 has no source
+  EXPECT_EQ(0, setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, DIY_FIRST_ID, 0, 0, 10, UNIT_RAW, 0));
+  g_model.telemetrySensors[1].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[1].formula = TELEM_FORMULA_ADD;
+  g_model.telemetrySensors[1].calc.sources[0] = 3;
+  g_model.telemetrySensors[2].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[2].formula = TELEM_FORMULA_ADD;
+  g_model.telemetrySensors[2].calc.sources[0] = 1;
+  g_model.telemetrySensors[3].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[3].formula = TELEM_FORMULA_ADD;
+
+  // no lag: sensor 2 uses the new value of sensor 3
+  evalCalculatedSensors();
+  EXPECT_EQ(10, telemetryItems[2].value);
+  EXPECT_EQ(10, telemetryItems[1].value);
+  EXPECT_TRUE(telemetryItems[3].isAvailable());
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, DIY_FIRST_ID, 0, 0, 20, UNIT_RAW, 0);
+  evalCalculatedSensors();
+  EXPECT_EQ(20, telemetryItems[2].value);
+  EXPECT_EQ(20, telemetryItems[1].value);
+
+  // not evaluated again without a new value
+  telemetryItems[1].value = 0;
+  evalCalculatedSensors();
+  EXPECT_EQ(0, telemetryItems[1].value);
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, DIY_FIRST_ID, 0, 0, 30, UNIT_RAW, 0);
+  evalCalculatedSensors();
+  EXPECT_EQ(30, telemetryItems[1].value);
+
+  telemetryItems[0].setOld();
+  evalCalculatedSensors();
+  EXPECT_TRUE(telemetryItems[2].isOld());
+  EXPECT_TRUE(telemetryItems[1].isOld());
+
+  // a source changed without telemetrySensorsChanged()
+  g_model.telemetrySensors[1].calc.sources[0] = 1;
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, DIY_FIRST_ID, 0, 0, 40, UNIT_RAW, 0);
+  g_model.telemetrySensors[2].calc.sources[0] = 0;
+  evalCalculatedSensors();
+  EXPECT_EQ(40, telemetryItems[1].value);
+}
@@ -119,5 +119,44 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
 }
 #endif // #if defined(GVARS)
 
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+TEST_F(SpecialFunctionsTest, SharedTrigger)
+{
+  // two functions on SAdown, one slot left empty between them
+  for (uint8_t i = 0; i < 3; i += 2) {
+    g_model.customFn[i].swtch = SWSRC_FIRST_SWITCH;
+    g_model.customFn[i].func = FUNC_OVERRIDE_CHANNEL;
+    g_model.customFn[i].all.param = i;
+    g_model.customFn[i].all.val = 10 + i;
+    g_model.customFn[i].active = true;
+  }
+
+  simuSetSwitch(0, 0);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[2], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(modelFunctionsContext.activeSwitches, 0u);
+
+  simuSetSwitch(0, -1);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], 10);
+  EXPECT_EQ(safetyCh[2], 12);
+  EXPECT_EQ(modelFunctionsContext.activeSwitches, 0x05u);
+
+  g_model.customFn[2].active = false;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], 10);
+  EXPECT_EQ(safetyCh[2], OVERRIDE_CHANNEL_UNDEFINED);
+
+  // trigger changed: the function follows its new switch
+  g_model.customFn[0].swtch = SWSRC_FIRST_SWITCH + 1;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], OVERRIDE_CHANNEL_UNDEFINED);
+  simuSetSwitch(0, 0);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], 10);
+}
+#endif // #if defined(OVERRIDE_CHANNEL_FUNCTION)
+
 #endif // #if defined(PCBFRSKY)
 
@@ -170,4 +170,67 @@ TEST(Lua, Switches)
   luaExecStr("if MIXSRC_SB == nil then error('failed') end");
 }
 
+TEST(Lua, FindFieldByName)
+{
+  MODEL_RESET();
+  telemetrySensorsChanged();
+
+  LuaField field;
+  EXPECT_TRUE(luaFindFieldByName("thr", field));
+  EXPECT_EQ(MIXSRC_FIRST_STICK + 2, field.id);
+  EXPECT_STREQ("thr", field.name);
+  EXPECT_TRUE(luaFindFieldByName("ch3", field));
+  EXPECT_EQ(MIXSRC_FIRST_CH + 2, field.id);
+  EXPECT_FALSE(luaFindFieldByName("RSSI", field));
+
+  // a new sensor
+  g_model.telemetrySensors[2].init("RSSI");
+  telemetrySensorsChanged();
+  EXPECT_TRUE(luaFindFieldByName("RSSI", field));
+  EXPECT_EQ(MIXSRC_FIRST_TELEM + 6, field.id);
+  EXPECT_TRUE(luaFindFieldByName("RSSI+", field));
+  EXPECT_EQ(MIXSRC_FIRST_TELEM + 8, field.id);
+  EXPECT_STREQ("RSSI+", field.name);
+
+  // renamed without notification
+  strncpy(g_model.telemetrySensors[2].label, "RxBt", TELEM_LABEL_LEN);
+  EXPECT_FALSE(luaFindFieldByName("RSSI", field));
+  EXPECT_TRUE(luaFindFieldByName("RxBt-", field));
+  EXPECT_EQ(MIXSRC_FIRST_TELEM + 7, field.id);
+
+  // the first field with a given id
+  EXPECT_TRUE(luaFindFieldById(MIXSRC_MAX, field));
+  EXPECT_STREQ("min", field.name);
+  EXPECT_TRUE(luaFindFieldById(MIXSRC_FIRST_STICK + 3, field));
+  EXPECT_STREQ("ail", field.name);
+  EXPECT_TRUE(luaFindFieldById(MIXSRC_FIRST_CH + 2, field));
+  EXPECT_STREQ("ch3", field.name);
+  EXPECT_FALSE(luaFindFieldById(MIXSRC_NONE, field));
+}
+
+TEST(Lua, GetValues)
+{
+  MODEL_RESET();
+  MIXER_RESET();
+  g_model.gvars[0].prec = 1;
+  g_model.flightModeData[0].gvars[0] = 12;
+  ex_chans[2] = 345;
+
+  luaExecStr("values = getValues({'ch3', getFieldInfo('gvar1').id, 'xyz'})");
+  luaExecStr("if #values ~= 3 then error('count') end");
+  luaExecStr("if values[1] ~= getValue('ch3') or values[1] ~= 345 then error('ch3') end");
+  luaExecStr("if values[2] ~= getValue('gvar1') then error('gvar1') end");
+  luaExecStr("if values[3] ~= 0 then error('xyz') end");
+
+  // the same table is filled again
+  luaExecStr("same = getValues({'ch3'}, values)");
+  luaExecStr("if same ~= values or values[1] ~= 345 then error('reuse') end");
+
+  // a dashboard widget refresh
+  luaExecStr("sources = {}");
+  luaExecStr("for i = 1, 20 do sources[i] = getFieldInfo('ch' .. i).id end");
+  luaExecStr("getValues(sources, values)");
+  luaExecStr("for j = 1, 20 do if values[j] ~= getValue(sources[j]) then error('ch' .. j) end end");
+}
+
 #endif   // #if defined(LUA)
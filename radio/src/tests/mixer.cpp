@@ -21,6 +21,8 @@
 
 #include "gtests.h"
 #include "hal/adc_driver.h"
+#include "mixes.h"
+#include "mixer_stats.h"
 
 class TrimsTest : public OpenTxTest {};
 class MixerTest : public OpenTxTest {};
@@ -524,6 +526,66 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCache)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+
+  // 17 points standard curve, 9 points custom curve
+  g_model.curves[0].smooth = 1;
+  g_model.curves[0].points = 12;
+  g_model.curves[1].type = CURVE_TYPE_CUSTOM;
+  g_model.curves[1].smooth = 1;
+  g_model.curves[1].points = 4;
+  loadCurves();
+
+  int8_t * points = curveAddress(0);
+  for (int i = 0; i < 17; i++) {
+    points[i] = (i * 37) % 201 - 100;
+  }
+  points = curveAddress(1);
+  for (int i = 0; i < 9; i++) {
+    points[i] = 100 - i * i * 2;
+  }
+  for (int i = 0; i < 7; i++) {
+    points[9 + i] = -90 + i * i * 4;
+  }
+  EXPECT_FALSE(isCurveCached(0));
+  EXPECT_FALSE(isCurveCached(1));
+
+  std::vector<int> expected;
+  for (uint8_t idx = 0; idx < 2; idx++) {
+    for (int x = -RESX - 10; x <= RESX + 10; x++) {
+      expected.push_back(applyCustomCurve(x, idx));
+    }
+  }
+
+  curvesCacheUpdate();
+  EXPECT_TRUE(isCurveCached(0));
+  EXPECT_TRUE(isCurveCached(1));
+
+  auto value = expected.begin();
+  for (uint8_t idx = 0; idx < 2; idx++) {
+    for (int x = -RESX - 10; x <= RESX + 10; x++) {
+      EXPECT_EQ(*value++, applyCustomCurve(x, idx));
+    }
+  }
+
+  // an edited curve is not used until the cache is updated
+  curveAddress(1)[4] = 0;
+  EXPECT_FALSE(isCurveCached(1));
+  EXPECT_EQ(0, applyCustomCurve(calc100toRESX(-54), 1));
+  curvesCacheUpdate();
+  EXPECT_TRUE(isCurveCached(1));
+
+  // X values not in ascending order are not cached
+  curveAddress(1)[10] = 50;
+  curvesCacheUpdate();
+  EXPECT_FALSE(isCurveCached(1));
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -541,6 +603,43 @@ TEST_F(MixerTest, InfiniteRecursiveChannels)
   EXPECT_EQ(chans[2], 0);
   EXPECT_EQ(chans[1], 0);
   EXPECT_EQ(chans[0], 0);
+  EXPECT_TRUE(isMixChannelInLoop(0));
+  EXPECT_TRUE(isMixChannelInLoop(1));
+  EXPECT_TRUE(isMixChannelInLoop(2));
+  EXPECT_FALSE(isMixChannelInLoop(3));
+}
+
+TEST_F(MixerTest, ChannelLoopUsesPreviousCycle)
+{
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  // CH1 = CH2 / 2, CH2 = MAX / 2 + CH1 / 2, CH3 = CH2
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[0].weight = 50;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 50;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[2].weight = 50;
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[3].weight = 100;
+
+  // CH1 is computed first, from CH2 in the previous cycle (0)
+  evalMixes(0);
+  EXPECT_EQ(chans[0], 0);
+  EXPECT_EQ(chans[1], CHANNEL_MAX/2);
+  EXPECT_EQ(chans[2], CHANNEL_MAX/2);
+
+  evalMixes(0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX/4);
+  EXPECT_EQ(chans[1], CHANNEL_MAX/2 + CHANNEL_MAX/8);
+  EXPECT_EQ(chans[2], CHANNEL_MAX/2 + CHANNEL_MAX/8);
+
+  EXPECT_TRUE(isMixChannelInLoop(0));
+  EXPECT_TRUE(isMixChannelInLoop(1));
+  EXPECT_FALSE(isMixChannelInLoop(2));
 }
 
 TEST_F(MixerTest, BlockingChannel)
@@ -572,6 +671,42 @@ TEST_F(MixerTest, RecursiveAddChannel)
   EXPECT_EQ(chans[1], 0);
 }
 
+TEST_F(MixerTest, LongChannelChain)
+{
+  // CH1 <- CH2 <- ... <- CH8 <- MAX, lines in reverse dependency order
+  for (int i = 0; i < 8; i++) {
+    g_model.mixData[i].destCh = i;
+    g_model.mixData[i].srcRaw = (i == 7 ? MIXSRC_MAX : MIXSRC_FIRST_CH + i + 1);
+    g_model.mixData[i].weight = 100;
+  }
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(chans[i], CHANNEL_MAX);
+  }
+}
+
+TEST_F(MixerTest, MixPlanFollowsEdits)
+{
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+  EXPECT_EQ(chans[1], 0);
+
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[1].weight = 50;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[1], CHANNEL_MAX/2);
+
+  g_model.mixData[0].srcRaw = MIXSRC_MIN;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], -CHANNEL_MAX);
+  EXPECT_EQ(chans[1], -CHANNEL_MAX/2);
+}
+
 TEST_F(MixerTest, RecursiveAddChannelAfterInactivePhase)
 {
   g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 1;
@@ -865,6 +1000,119 @@ TEST_F(MixerTest, flightModeOverflow)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, 1024);
 }
 
+TEST_F(MixerTest, flightModeTransitionGVarWeight)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[1].fadeIn = 100;
+  g_model.flightModeData[1].fadeOut = 100;
+  g_model.flightModeData[0].gvars[0] = 100;
+  g_model.flightModeData[1].gvars[0] = -50;
+  // CH1 = MAX * GV1, CH2 = MAX / 2 in all flight modes, CH3 = CH1
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = -GV1_LARGE;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 50;
+  g_model.mixData[2].destCh = 2;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[2].weight = 100;
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], 1024);
+  simuSetSwitch(0, 1);
+  evalMixes(1);
+  for (int i = 0; i < 500; i++) {
+    evalMixes(1);
+    EXPECT_EQ(channelOutputs[1], 512);
+    EXPECT_EQ(channelOutputs[2], channelOutputs[0]);
+  }
+  EXPECT_LT(channelOutputs[0], 1024);
+  EXPECT_GT(channelOutputs[0], -512);
+  for (int i = 0; i < 600; i++) {
+    evalMixes(1);
+  }
+  EXPECT_EQ(channelOutputs[0], -512);
+  EXPECT_EQ(channelOutputs[2], -512);
+}
+
+TEST_F(MixerTest, flightModeTransitionAllMixes)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[1].fadeIn = 100;
+  g_model.flightModeData[1].fadeOut = 100;
+  // 2 lines per channel, the second one of CH1..CH4 only active in FM0
+  for (int i = 0; i < MAX_MIXERS; i++) {
+    MixData * md = &g_model.mixData[i];
+    md->destCh = i / 2;
+    if (i % 2) {
+      md->srcRaw = MIXSRC_MAX;
+      md->weight = 10;
+      if (i / 2 < 4) md->flightModes = 0b11110;
+    }
+    else {
+      md->srcRaw = MIXSRC_FIRST_STICK + (i / 2) % 4;
+      md->weight = 100;
+    }
+  }
+
+  evalMixes(1);
+  for (int c = 0; c < 100; c++) evalMixes(0);
+  int16_t steadyValues[] = { channelOutputs[0], channelOutputs[4] };
+
+  simuSetSwitch(0, 1);
+  for (int i = 0; i < 200; i++) evalMixes(1);
+  int16_t fadingValue = channelOutputs[0];
+  for (int c = 0; c < 100; c++) evalMixes(0);
+
+  EXPECT_EQ(channelOutputs[0], fadingValue);
+  EXPECT_LT(channelOutputs[0], steadyValues[0]);
+  EXPECT_GT(channelOutputs[0], steadyValues[0] - 102);
+  EXPECT_EQ(channelOutputs[4], steadyValues[1]);
+}
+
+TEST(MixerStats, histogram)
+{
+  EXPECT_EQ(mixerStatsBucket(0), 0);
+  EXPECT_EQ(mixerStatsBucket(1), 1);
+  EXPECT_EQ(mixerStatsBucket(1000), 10);
+  EXPECT_EQ(mixerStatsBucket(1024), 11);
+  EXPECT_EQ(mixerStatsBucket(1000000), MIXER_STATS_BUCKETS - 1);
+
+  mixerStatsReset();
+  mixerStatsCycleStart(10000, 4000);
+  mixerStatsCycleEnd(500, 4000);
+  mixerStatsCycleStart(14100, 4000);
+  mixerStatsCycleEnd(510, 4000);
+  mixerStatsCycleStart(18000, 4000);
+  mixerStatsCycleEnd(4500, 4000);
+
+  EXPECT_EQ(mixerStats.cycles, 3u);
+  EXPECT_EQ(mixerStats.overruns, 1u);
+  EXPECT_EQ(mixerStats.jitterMax, 100);
+  EXPECT_EQ(mixerStats.jitterHistogram[mixerStatsBucket(100)], 2u);
+  EXPECT_EQ(mixerStats.cycleHistogram[mixerStatsBucket(500)], 2u);
+  EXPECT_EQ(mixerStatsPercentile(mixerStats.cycleHistogram, 50), 512u);
+  EXPECT_EQ(mixerStatsPercentile(mixerStats.cycleHistogram, 99), 8192u);
+
+  // no jitter across a pause
+  mixerStatsPause();
+  mixerStatsCycleStart(100000, 4000);
+  EXPECT_EQ(mixerStats.jitterMax, 100);
+
+  mixerStatsReset();
+  EXPECT_EQ(mixerStats.cycles, 0u);
+}
+
 TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 {
   g_model.thrTrim = 1;
@@ -20,6 +20,7 @@
  */
 
 #include "gtests.h"
+#include "sources.h"
 
 #include "storage/yaml/yaml_tree_walker.h"
 #include "storage/yaml/yaml_parser.h"
@@ -116,3 +117,32 @@ TEST(Sources, getSourceString)
   EXPECT_STREQ(getSourceString(MIXSRC_TrimEle), STR_CHAR_TRIM "Ele");
   EXPECT_STREQ(getSourceString(MIXSRC_TrimThr), STR_CHAR_TRIM "Thr");
 }
+
+class SourceRefTest : public OpenTxTest {};
+
+static void setSourceTestValues()
+{
+  for (int i = 0; i < MAX_INPUTS; i++) anas[i] = 10 * i - 200;
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) calibratedAnalogs[i] = 3 * i - 50;
+  for (int i = 0; i < MAX_OUTPUT_CHANNELS; i++) ex_chans[i] = 5 * i + 1;
+  for (int i = 0; i < TIMERS; i++) timersStates[i].val = 60 * i + 7;
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    telemetryItems[i].value = 1000 + i;
+    telemetryItems[i].valueMin = -i;
+    telemetryItems[i].valueMax = 2000 + i;
+  }
+  g_vbat100mV = 74;
+}
+
+// The cost of both lookups on a 64 mix lines model is compared by
+// "mixer-bench -s" (radio/src/benchmarks), on the heavy.yml model
+TEST_F(SourceRefTest, sameValueAsGetValue)
+{
+  setSourceTestValues();
+
+  for (mixsrc_t src = MIXSRC_NONE; src <= MIXSRC_LAST_TELEM; src++) {
+    SourceRef ref;
+    resolveSource(ref, src);
+    EXPECT_EQ(getValue(ref), getValue(src)) << "source " << src;
+  }
+}
@@ -20,6 +20,7 @@
  */
 
 #include "gtests.h"
+#include "location.h"
 
 void setLogicalSwitch(int index, uint16_t _func, int16_t _v1, int16_t _v2, int16_t _v3 = 0, uint8_t _delay = 0, uint8_t _duration = 0, int8_t _andsw = 0)
 {
@@ -68,6 +69,47 @@ TEST(getSwitch, OldTypeStickyCSW)
   EXPECT_EQ(getSwitch(SWSRC_SW1), false);
   EXPECT_EQ(getSwitch(SWSRC_SW2), false);
 }
+
+TEST(evalLogicalSwitches, dependencyOrder)
+{
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 uses L3, L2 uses L1 as AND switch, L5 and L6 use each other
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_FIRST_LOGICAL_SWITCH + 2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_ON, SWSRC_NONE, 0, 0, 0, SWSRC_SW1);
+  setLogicalSwitch(2, LS_FUNC_AND, SWSRC_FIRST_SWITCH, SWSRC_NONE);
+  setLogicalSwitch(4, LS_FUNC_AND, SWSRC_FIRST_LOGICAL_SWITCH + 5, SWSRC_NONE);
+  setLogicalSwitch(5, LS_FUNC_AND, SWSRC_FIRST_LOGICAL_SWITCH + 4, SWSRC_NONE);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+
+  // no lag: L1 and L2 follow L3 in the same pass
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + 2), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + 4), false);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+
+  // a deleted switch is off
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  setLogicalSwitch(2, LS_FUNC_NONE, 0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + 2), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  simuSetSwitch(0, 0);
+}
 #endif
 
 TEST(getSwitch, nullSW)
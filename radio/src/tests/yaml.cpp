@@ -19,12 +19,18 @@
  * GNU General Public License for more details.
  */
 
+#include <string>
+
 #include "gtests.h"
 
 #include <storage/yaml/yaml_node.h>
 #include <storage/yaml/yaml_parser.h>
 #include <storage/yaml/yaml_tree_walker.h>
 
+#if defined(SDCARD_YAML)
+  #include <storage/yaml/yaml_datastructs.h>
+#endif
+
 struct TestStruct {
   uint8_t foo;
   uint8_t bar;
@@ -68,3 +74,91 @@ TEST(Yaml, SkipBlankLines)
   EXPECT_EQ(YamlParser::CONTINUE_PARSING, yp.parse(chunk_3, sizeof(chunk_3) - 1));
   EXPECT_EQ(45, t.foo);
 }
+
+TEST(Yaml, KeysOutOfOrder)
+{
+  TestStruct t;
+
+  YamlTreeWalker tree;
+  tree.reset(&_root_node, (uint8_t*)&t);
+
+  const char yaml[] =
+      "testStruct:\n  bar: 34\n  unknown: 1\n  foo: 12\n  bar: 56\n";
+
+  YamlParser yp;
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+  EXPECT_EQ(YamlParser::CONTINUE_PARSING, yp.parse(yaml, sizeof(yaml) - 1));
+  EXPECT_EQ(12, t.foo);
+  EXPECT_EQ(56, t.bar);
+}
+
+#if defined(SDCARD_YAML)
+
+static bool yamlAppend(void* opaque, const char* str, size_t len)
+{
+  ((std::string*)opaque)->append(str, len);
+  return true;
+}
+
+static std::string generateModelYaml(ModelData* model)
+{
+  std::string yaml;
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t*)model);
+  tree.generate(yamlAppend, &yaml);
+  return yaml;
+}
+
+static void parseModelYaml(ModelData* model, const std::string& yaml)
+{
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t*)model);
+
+  YamlParser yp;
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+  yp.parse(yaml.data(), yaml.size());
+}
+
+TEST(Yaml, ModelRoundTrip)
+{
+  MODEL_RESET();
+  strcpy(g_model.header.name, "Yaml");
+  g_model.timers[0].mode = TMRMODE_ON;
+  g_model.timers[0].start = 300;
+  for (int i = 0; i < MAX_EXPOS; i++) {
+    g_model.expoData[i].chn = i % 4;
+    g_model.expoData[i].srcRaw = MIXSRC_FIRST_STICK + i % 4;
+    g_model.expoData[i].weight = 100 - i;
+    g_model.expoData[i].curve.type = CURVE_REF_EXPO;
+    g_model.expoData[i].curve.value = i;
+  }
+  for (int i = 0; i < MAX_MIXERS; i++) {
+    g_model.mixData[i].destCh = i / 4;
+    g_model.mixData[i].srcRaw = MIXSRC_FIRST_STICK + i % 4;
+    g_model.mixData[i].weight = 100 - i;
+    g_model.mixData[i].offset = i;
+    g_model.mixData[i].speedUp = i % 10;
+  }
+  for (int i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    g_model.logicalSw[i].func = LS_FUNC_VPOS;
+    g_model.logicalSw[i].v1 = MIXSRC_FIRST_STICK + i % 4;
+    g_model.logicalSw[i].v2 = i;
+    g_model.logicalSw[i].duration = i % 5;
+  }
+  for (int i = 0; i < MAX_FLIGHT_MODES; i++) {
+    g_model.flightModeData[i].fadeIn = i;
+    g_model.flightModeData[i].fadeOut = i;
+  }
+
+  std::string yaml = generateModelYaml(&g_model);
+
+  static ModelData model;
+  memset(&model, 0, sizeof(model));
+  parseModelYaml(&model, yaml);
+
+  EXPECT_EQ(yaml, generateModelYaml(&model));
+}
+
+#endif
@@ -271,6 +271,9 @@ const char STR_NODATA[] = TR_NODATA;
 const char STR_US[] = TR_US;
 const char STR_HZ[]  = TR_HZ;
 const char STR_TMIXMAXMS[] = TR_TMIXMAXMS;
+const char STR_TMIX99[] = TR_TMIX99;
+const char STR_MIXER_JITTER[] = TR_MIXER_JITTER;
+const char STR_MIXER_OVERRUNS[] = TR_MIXER_OVERRUNS;
 const char STR_FREE_STACK[] = TR_FREE_STACK;
 const char STR_INT_GPS_LABEL[]  = TR_INT_GPS_LABEL;
 const char STR_HEARTBEAT_LABEL[]  = TR_HEARTBEAT_LABEL;
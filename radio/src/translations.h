@@ -462,6 +462,9 @@ extern const char STR_NODATA[];
 extern const char STR_US[];
 extern const char STR_HZ[];
 extern const char STR_TMIXMAXMS[];
+extern const char STR_TMIX99[];
+extern const char STR_MIXER_JITTER[];
+extern const char STR_MIXER_OVERRUNS[];
 extern const char STR_FREE_STACK[];
 extern const char STR_INT_GPS_LABEL[];
 extern const char STR_HEARTBEAT_LABEL[];
@@ -420,6 +420,9 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIX99                      "Tmix 99%"
+#define TR_MIXER_JITTER                "Mix jitter"
+#define TR_MIXER_OVERRUNS              "Overruns"
 #define TR_FREE_STACK                  "Fri stak"
 #define TR_INT_GPS_LABEL               "Intern GPS"
 #define TR_HEARTBEAT_LABEL             "Hjerte puls"
@@ -412,6 +412,9 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "TmixMaks"
+#define TR_TMIX99                     "Tmix 99%"
+#define TR_MIXER_JITTER               "Mix jitter"
+#define TR_MIXER_OVERRUNS             "Overruns"
 #define TR_FREE_STACK                 "Wolny stos"
 #define TR_INT_GPS_LABEL              "Wewnęt. GPS"
 #define TR_HEARTBEAT_LABEL            "Heartbeat"